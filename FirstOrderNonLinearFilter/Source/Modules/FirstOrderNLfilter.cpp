@@ -28,7 +28,7 @@ void FirstOrderNLfilter<SampleType>::setFrequency(SampleType newFreq)
     if (hz != newFreq)
     {
         hz = juce::jlimit(minFreq, maxFreq, newFreq);
-        coefficients();
+        dirty = true;
     }
 }
 
@@ -38,7 +38,7 @@ void FirstOrderNLfilter<SampleType>::setGain(SampleType newGain)
     if (g != newGain)
     {
         g = newGain;
-        coefficients();
+        dirty = true;
     }
 }
 
@@ -49,7 +49,7 @@ void FirstOrderNLfilter<SampleType>::setFilterType(filterType newFiltType)
     {
         filtType = newFiltType;
         reset();
-        coefficients();
+        dirty = true;
     }
 }
 
@@ -60,10 +60,32 @@ void FirstOrderNLfilter<SampleType>::setSaturationType(satType newTransformType)
     {
         saturationType = newTransformType;
         reset();
+        dirty = true;
+    }
+}
+
+template <typename SampleType>
+void FirstOrderNLfilter<SampleType>::updateCoefficients() noexcept
+{
+    if (dirty)
+    {
+        dirty = false;
         coefficients();
     }
 }
 
+template <typename SampleType>
+void FirstOrderNLfilter<SampleType>::setAntiAliasing(aaType newAntiAliasing)
+{
+    if (antiAliasing != newAntiAliasing)
+    {
+        antiAliasing = newAntiAliasing;
+
+        for (auto sat : { &satB0, &satB1, &satA1 })
+            sat->setAntiAliasing(antiAliasing);
+    }
+}
+
 //==============================================================================
 template <typename SampleType>
 void FirstOrderNLfilter<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
@@ -77,6 +99,9 @@ void FirstOrderNLfilter<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
     Xn_1.resize(spec.numChannels);
     Yn_1.resize(spec.numChannels);
 
+    for (auto sat : { &satB0, &satB1, &satA1 })
+        sat->prepare(spec);
+
     reset();
 
     minFreq = static_cast <SampleType> (sampleRate / 24576.0);
@@ -88,6 +113,7 @@ void FirstOrderNLfilter<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
     setFrequency(hz);
     setGain(g);
 
+    dirty = false;
     coefficients();
 }
 
@@ -96,112 +122,9 @@ void FirstOrderNLfilter<SampleType>::reset(SampleType initialValue)
 {
     for (auto v : { &Wn_1, &Xn_1, &Yn_1, })
         std::fill(v->begin(), v->end(), initialValue);
-}
-
-template <typename SampleType>
-SampleType FirstOrderNLfilter<SampleType>::processSample(int channel, SampleType inputValue)
-{
-    jassert(juce::isPositiveAndBelow(channel, Wn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Xn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
-
-    switch (saturationType)
-    {
-    case SaturationType::linear:
-        inputValue = linear(channel, inputValue);
-        break;
-    case SaturationType::nonlinear1:
-        inputValue = nonlinear1(channel, inputValue);
-        break;
-    case SaturationType::nonlinear2:
-        inputValue = nonlinear2(channel, inputValue);
-        break;
-    case SaturationType::nonlinear3:
-        inputValue = nonlinear3(channel, inputValue);
-        break;
-    case SaturationType::nonlinear4:
-        inputValue = nonlinear4(channel, inputValue);
-        break;
-    default:
-        inputValue = linear(channel, inputValue);
-    }
-
-    return inputValue;
-}
-
-template <typename SampleType>
-SampleType FirstOrderNLfilter<SampleType>::linear(int channel, SampleType inputSample)
-{
-    auto& Xn1 = Xn_1[(size_t)channel];
-
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
-
-    Yn = ((Xn * b0) + Xn1);
-
-    Xn1 = ((Xn * b1) + (Yn * a1));
-
-    return Yn;
-}
-
-template <typename SampleType>
-SampleType FirstOrderNLfilter<SampleType>::nonlinear1(int channel, SampleType inputSample)
-{
-    auto& Xn1 = Xn_1[(size_t)channel];
-
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
-
-    Yn = (std::tanh(Xn * b0) + Xn1);
-
-    Xn1 = ((Xn * b1) + (Yn * a1));
-
-    return Yn;
-}
-
-template <typename SampleType>
-SampleType FirstOrderNLfilter<SampleType>::nonlinear2(int channel, SampleType inputSample)
-{
-    auto& Xn1 = Xn_1[(size_t)channel];
-
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
-
-    Yn = ((Xn * b0) + Xn1);
-
-    Xn1 = (std::tanh(Xn * b1) + (Yn * a1));
-
-    return Yn;
-}
-
-template <typename SampleType>
-SampleType FirstOrderNLfilter<SampleType>::nonlinear3(int channel, SampleType inputSample)
-{
-    auto& Xn1 = Xn_1[(size_t)channel];
-
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
-
-    Yn = ((Xn * b0) + Xn1);
-
-    Xn1 = ((Xn * b1) + std::tanh(Yn * a1));
-
-    return Yn;
-}
-
-template <typename SampleType>
-SampleType FirstOrderNLfilter<SampleType>::nonlinear4(int channel, SampleType inputSample)
-{
-    auto& Xn1 = Xn_1[(size_t)channel];
-
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
-
-    Yn = (std::tanh(Xn * b0) + Xn1);
-
-    Xn1 = (std::tanh(Xn * b1) + std::tanh(Yn * a1));
 
-    return Yn;
+    for (auto sat : { &satB0, &satB1, &satA1 })
+        sat->reset();
 }
 
 //template <typename SampleType>
@@ -268,7 +191,7 @@ template <typename SampleType>
 void FirstOrderNLfilter<SampleType>::coefficients()
 {
     omega = (hz * ((pi * two) / static_cast <SampleType>(sampleRate)));
-    a = (std::pow(SampleType(10), (g * SampleType(0.05))));
+    a = FastMath<SampleType>::decibelsToGain(g);
     omegaDivA = omega / a;
     omegaMulA = omega * a;
 
@@ -13,6 +13,8 @@
 #include <JuceHeader.h>
 
 #include "Coefficient.h"
+#include "Saturator.h"
+#include "FastMath.h"
 
 #ifndef FIRSTORDERNLFILTER_H_INCLUDED
 #define FIRSTORDERNLFILTER_H_INCLUDED
@@ -59,6 +61,7 @@ class FirstOrderNLfilter
 public:
     using filterType = FilterType;
     using satType = SaturationType;
+    using aaType = AntiAliasingType;
     //==============================================================================
     /** Constructor. */
     FirstOrderNLfilter();
@@ -76,6 +79,14 @@ public:
     /** Sets the BiLinear Transform for the filter to use. See enum for available types. */
     void setSaturationType(satType newTransformType);
 
+    /** Redesigns the coefficients if any of the settings above have changed
+    since the last call. process() calls this once per block; call it yourself
+    before using processSample() directly. */
+    void updateCoefficients() noexcept;
+
+    /** Sets the anti-aliasing order of the saturators. See enum for available types. */
+    void setAntiAliasing(aaType newAntiAliasing);
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare(juce::dsp::ProcessSpec& spec);
@@ -102,6 +113,8 @@ public:
         jassert(inputBlock.getNumChannels() == numChannels);
         jassert(inputBlock.getNumSamples() == numSamples);
 
+        updateCoefficients();
+
         if (context.isBypassed)
         {
             outputBlock.copyFrom(inputBlock);
@@ -148,6 +161,10 @@ private:
     /** Unit-delay objects. */
     std::vector<SampleType> Wn_1, Xn_1, Yn_1;
 
+    //==========================================================================
+    /** Saturators, one per coefficient path. */
+    Saturator<SampleType> satB0, satB1, satA1;
+
     //==========================================================================
     /** Coefficient gain */
     Coefficient<SampleType> b0, b1, a0, a1;
@@ -161,6 +178,8 @@ private:
     SampleType minFreq = 20.0, maxFreq = 20000.0, hz = 1000.0, g = 0.0;
     filterType filtType = filterType::lowPass;
     satType saturationType = satType::linear;
+    aaType antiAliasing = aaType::none;
+    bool dirty = false;
 
     SampleType omega, a, omegaDivA, omegaMulA { 0.0 };
 
@@ -173,4 +192,115 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FirstOrderNLfilter)
 };
 
+//==============================================================================
+/*  The per-sample kernels are defined here rather than in FirstOrderNLfilter.cpp,
+    so they inline into process() and the sample loop needs no calls across
+    translation units. */
+
+template <typename SampleType>
+inline SampleType FirstOrderNLfilter<SampleType>::processSample(int channel, SampleType inputValue)
+{
+    jassert(juce::isPositiveAndBelow(channel, Wn_1.size()));
+    jassert(juce::isPositiveAndBelow(channel, Xn_1.size()));
+    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
+
+    switch (saturationType)
+    {
+    case SaturationType::linear:
+        inputValue = linear(channel, inputValue);
+        break;
+    case SaturationType::nonlinear1:
+        inputValue = nonlinear1(channel, inputValue);
+        break;
+    case SaturationType::nonlinear2:
+        inputValue = nonlinear2(channel, inputValue);
+        break;
+    case SaturationType::nonlinear3:
+        inputValue = nonlinear3(channel, inputValue);
+        break;
+    case SaturationType::nonlinear4:
+        inputValue = nonlinear4(channel, inputValue);
+        break;
+    default:
+        inputValue = linear(channel, inputValue);
+    }
+
+    return inputValue;
+}
+
+template <typename SampleType>
+inline SampleType FirstOrderNLfilter<SampleType>::linear(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = ((Xn * b0) + Xn1);
+
+    Xn1 = ((Xn * b1) + (Yn * a1));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType FirstOrderNLfilter<SampleType>::nonlinear1(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = (satB0.processSample(channel, Xn * b0) + Xn1);
+
+    Xn1 = ((Xn * b1) + (Yn * a1));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType FirstOrderNLfilter<SampleType>::nonlinear2(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = ((Xn * b0) + Xn1);
+
+    Xn1 = (satB1.processSample(channel, Xn * b1) + (Yn * a1));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType FirstOrderNLfilter<SampleType>::nonlinear3(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = ((Xn * b0) + Xn1);
+
+    Xn1 = ((Xn * b1) + satA1.processSample(channel, Yn * a1));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType FirstOrderNLfilter<SampleType>::nonlinear4(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = (satB0.processSample(channel, Xn * b0) + Xn1);
+
+    Xn1 = (satB1.processSample(channel, Xn * b1) + satA1.processSample(channel, Yn * a1));
+
+    return Yn;
+}
+
 #endif //FIRSTORDERNLFILTER_H_INCLUDED
@@ -30,6 +30,7 @@ void Parameters::setParameterLayout(Params& params)
     const auto fString = juce::StringArray({ "LP", "HP", "LS", "HS" , "LS(c)", "HS(c)" });
     const auto tString = juce::StringArray({ "Linear", "NL1", "NL2", "NL3", "NL4" });
     const auto osString = juce::StringArray({ "--", "2x", "4x", "8x", "16x" });
+    const auto aaString = juce::StringArray({ "--", "ADAA1", "ADAA2" });
 
     const auto decibels = juce::String{ ("dB") };
     const auto frequency = juce::String{ ("Hz") };
@@ -84,6 +85,7 @@ void Parameters::setParameterLayout(Params& params)
         (std::make_unique<juce::AudioProcessorParameterGroup>("masterID", "1", "seperatorB",
             //==================================================================
             std::make_unique<juce::AudioParameterChoice>("osID", "Oversampling", osString, 0),
+            std::make_unique<juce::AudioParameterChoice>("aaID", "Anti-alias", aaString, 0),
             std::make_unique<juce::AudioParameterFloat>("outputID", "Output", outputRange, 00.00f, outputAttributes),
             std::make_unique<juce::AudioParameterFloat>("mixID", "Mix", mixRange, 100.00f, mixAttributes)
             //==================================================================
@@ -27,6 +27,7 @@ ProcessWrapper<SampleType>::ProcessWrapper(FirstOrderNonLinearFilterAudioProcess
     typePtr (dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("typeID"))),
     linearityPtr (dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("linearityID"))),
     osPtr(dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("osID"))),
+    aaPtr(dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("aaID"))),
     outputPtr (dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("outputID"))),
     mixPtr (dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("mixID"))),
     drivePtr (dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("driveID")))
@@ -34,10 +35,14 @@ ProcessWrapper<SampleType>::ProcessWrapper(FirstOrderNonLinearFilterAudioProcess
     jassert(frequencyPtr != nullptr);
     jassert(gainPtr != nullptr);
     jassert(typePtr != nullptr);
+    jassert(aaPtr != nullptr);
     jassert(outputPtr != nullptr);
     jassert(mixPtr != nullptr);
     jassert(drivePtr != nullptr);
 
+    for (auto* parameter : getParameters())
+        parameter->addListener(this);
+
     auto osFilter = juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple;
 
     for (int i = 0; i < 5; ++i)
@@ -47,6 +52,13 @@ ProcessWrapper<SampleType>::ProcessWrapper(FirstOrderNonLinearFilterAudioProcess
     reset();
 }
 
+template <typename SampleType>
+ProcessWrapper<SampleType>::~ProcessWrapper()
+{
+    for (auto* parameter : getParameters())
+        parameter->removeListener(this);
+}
+
 template <typename SampleType>
 void ProcessWrapper<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
 {
@@ -66,6 +78,9 @@ void ProcessWrapper<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
     output.prepare(spec);
 
     reset();
+
+    // Apply everything afresh, whether or not it changed while stopped.
+    snapshotDirty.store(true, std::memory_order_release);
     update();
 }
 
@@ -90,7 +105,6 @@ void ProcessWrapper<SampleType>::process(juce::AudioBuffer<SampleType>& buffer,
     midiMessages.clear();
 
     update();
-    setOversampling();
 
     juce::dsp::AudioBlock<SampleType> block(buffer);
     juce::dsp::AudioBlock<SampleType> osBlock(buffer);
@@ -117,20 +131,26 @@ void ProcessWrapper<SampleType>::process(juce::AudioBuffer<SampleType>& buffer,
 template <typename SampleType>
 void ProcessWrapper<SampleType>::update()
 {
-    mixer.setWetMixProportion(mixPtr->get() * 0.01f);
-    driveUp.setGainDecibels(drivePtr->get() * static_cast<SampleType>(1.0));
-    filter.setFrequency(frequencyPtr->get() / oversamplingFactor);
-    filter.setGain(gainPtr->get());
-    filter.setFilterType(static_cast<FilterType>(typePtr->getIndex()));
-    filter.setSaturationType(static_cast<SaturationType>(linearityPtr->getIndex()));
-    driveDn.setGainDecibels(drivePtr->get() * static_cast<SampleType>(-1.0));
-    output.setGainDecibels(outputPtr->get());
+    if (! readSnapshot())
+        return;
+
+    setOversampling();
+
+    mixer.setWetMixProportion(static_cast<SampleType>(current.mix));
+    driveUp.setGainLinear(static_cast<SampleType>(current.driveGain));
+    filter.setFrequency(static_cast<SampleType>(current.frequency / oversamplingFactor));
+    filter.setGain(static_cast<SampleType>(current.gain));
+    filter.setFilterType(static_cast<FilterType>(current.type));
+    filter.setSaturationType(static_cast<SaturationType>(current.linearity));
+    filter.setAntiAliasing(static_cast<AntiAliasingType>(current.antiAliasing));
+    driveDn.setGainLinear(static_cast<SampleType>(1.0f / current.driveGain));
+    output.setGainLinear(static_cast<SampleType>(current.outputGain));
 }
 
 template <typename SampleType>
 void ProcessWrapper<SampleType>::setOversampling()
 {
-    curOS = (int)osPtr->getIndex();
+    curOS = current.oversampling;
     if (curOS != prevOS)
     {
         oversamplingFactor = 1 << curOS;
@@ -141,6 +161,39 @@ void ProcessWrapper<SampleType>::setOversampling()
     }
 }
 
+//==============================================================================
+template <typename SampleType>
+void ProcessWrapper<SampleType>::parameterValueChanged(int, float)
+{
+    snapshotDirty.store(true, std::memory_order_release);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::parameterGestureChanged(int, bool)
+{
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::readSnapshot() noexcept
+{
+    // The flag is cleared before the values are read, so a change landing
+    // part way through raises it again and is picked up next block.
+    if (! snapshotDirty.exchange(false, std::memory_order_acq_rel))
+        return false;
+
+    current.frequency = frequencyPtr->get();
+    current.gain = gainPtr->get();
+    current.mix = mixPtr->get() * 0.01f;
+    current.driveGain = juce::Decibels::decibelsToGain(drivePtr->get());
+    current.outputGain = juce::Decibels::decibelsToGain(outputPtr->get());
+    current.type = typePtr->getIndex();
+    current.linearity = linearityPtr->getIndex();
+    current.oversampling = osPtr->getIndex();
+    current.antiAliasing = aaPtr->getIndex();
+
+    return true;
+}
+
 //==============================================================================
 template class ProcessWrapper<float>;
 template class ProcessWrapper<double>;
\ No newline at end of file
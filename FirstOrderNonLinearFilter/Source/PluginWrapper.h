@@ -20,7 +20,7 @@
 class FirstOrderNonLinearFilterAudioProcessor;
 
 template <typename SampleType>
-class ProcessWrapper
+class ProcessWrapper : private juce::AudioProcessorParameter::Listener
 {
 public:
     using APVTS = juce::AudioProcessorValueTreeState;
@@ -29,6 +29,9 @@ public:
     /** Constructor. */
     ProcessWrapper(FirstOrderNonLinearFilterAudioProcessor& p);
 
+    /** Destructor. */
+    ~ProcessWrapper() override;
+
     //==========================================================================
     /** Initialises the processor. */
     void prepare(juce::dsp::ProcessSpec& spec);
@@ -40,7 +43,8 @@ public:
     void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
 
     //==========================================================================
-    /** Updates the internal state variables of the processor. */
+    /** Updates the internal state variables of the processor from the
+    parameter snapshot, if it has changed since the last update. */
     void update();
 
     //==========================================================================
@@ -48,6 +52,33 @@ public:
     void setOversampling();
 
 private:
+    //==========================================================================
+    /** The parameter values the processor needs, with gains already converted
+    from decibels. */
+    struct Snapshot
+    {
+        float frequency = 1000.0f, gain = 0.0f, mix = 1.0f;
+        float driveGain = 1.0f, outputGain = 1.0f;
+        int type = 0, linearity = 0, oversampling = 0, antiAliasing = 0;
+    };
+
+    //==========================================================================
+    /** Parameter listener callbacks, called from whichever thread changes the
+    parameter, which may be the audio thread. They only raise a flag, so
+    they never lock or wait. */
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+
+    /** Returns the parameters the snapshot is built from. */
+    std::array<juce::AudioProcessorParameter*, 9> getParameters() const noexcept
+    {
+        return { frequencyPtr, gainPtr, typePtr, linearityPtr, osPtr, aaPtr, outputPtr, mixPtr, drivePtr };
+    }
+
+    /** Rebuilds current from the parameter values if any of them has changed
+    since the last call. Returns true if it did. */
+    bool readSnapshot() noexcept;
+
     //==========================================================================
     // This reference is provided as a quick way for the wrapper to
     // access the processor object that created it.
@@ -71,10 +102,17 @@ private:
     juce::AudioParameterChoice* typePtr{ nullptr };
     juce::AudioParameterChoice* linearityPtr{ nullptr };
     juce::AudioParameterChoice* osPtr;
+    juce::AudioParameterChoice* aaPtr{ nullptr };
     juce::AudioParameterFloat* outputPtr{ nullptr };
     juce::AudioParameterFloat* mixPtr{ nullptr };
     juce::AudioParameterFloat* drivePtr{ nullptr };
 
+    //==========================================================================
+    /** Parameter snapshot, owned by the audio thread. The parameters hold
+    their values atomically, so the flag is all the listeners publish. */
+    Snapshot current;
+    std::atomic<bool> snapshotDirty{ true };
+
     //==========================================================================
     /** Init variables. */
     int curOS = 0, prevOS = 0, oversamplingFactor = 1;
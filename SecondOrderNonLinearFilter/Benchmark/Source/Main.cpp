@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 9:58:06am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../../Source/Modules/SecondOrderNLfilter.h"
+#include "../../Source/Modules/FilterBank.h"
+#include "../../Source/Modules/MultibandSaturator.h"
+
+/*  Times the dispatched kernels at every variant the CPU can run, and the
+    main filter's stereo path at the baseline, in float and in double. Each
+    cost is printed per sample and channel. Build the Release configuration;
+    a debug build only measures the debugger. */
+
+#if JUCE_MSVC
+ #define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+ #define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 256;
+    constexpr int numBlocks = 4000;
+
+    //==============================================================================
+    /** Returns the best of a few timings of numBlocks calls, in nanoseconds
+    per sample and channel. */
+    template <typename Function>
+    double time(int numChannels, Function&& processBlock)
+    {
+        auto best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < 4; ++run)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            for (int block = 0; block < numBlocks; ++block)
+                processBlock();
+
+            const auto ticks = juce::Time::getHighResolutionTicks() - start;
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(ticks);
+
+            // The first run only warms the caches.
+            if (run > 0)
+                best = juce::jmin(best, seconds);
+        }
+
+        return best * 1.0e9 / ((double)numBlocks * blockSize * numChannels);
+    }
+
+    /** Fills a buffer with noise at -6 dB, so the saturators have something
+    to work on. */
+    template <typename SampleType>
+    void fillWithNoise(juce::AudioBuffer<SampleType>& buffer)
+    {
+        juce::Random random(1);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, static_cast<SampleType>(random.nextFloat() - 0.5f));
+    }
+
+    //==============================================================================
+    /** The main filter on a stereo block, at one saturation position. With
+    no anti-aliasing it takes the lane-parallel path, as the plugin does. */
+    template <typename SampleType>
+    double timeFilter(SaturationType saturation)
+    {
+        constexpr int numChannels = 2;
+
+        SecondOrderNLfilter<SampleType> filter;
+        juce::dsp::ProcessSpec spec{ sampleRate, (juce::uint32)blockSize, numChannels };
+        filter.prepare(spec);
+        filter.setFilterType(FilterType::lowPass2);
+        filter.setResonance(static_cast<SampleType>(0.7));
+        filter.setSaturationType(saturation);
+
+        juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> inputGain, outputGain;
+        inputGain.setCurrentAndTargetValue(static_cast<SampleType>(4.0));
+        outputGain.setCurrentAndTargetValue(static_cast<SampleType>(0.25));
+
+        juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+        fillWithNoise(buffer);
+
+        return time(numChannels, [&]
+        {
+            juce::dsp::AudioBlock<SampleType> block(buffer);
+            juce::dsp::ProcessContextReplacing<SampleType> context(block);
+            filter.process(context, inputGain, outputGain);
+        });
+    }
+
+    /** Calls processSample() without letting the compiler inline it, as every
+    sample did while it was defined in SecondOrderNLfilter.cpp. */
+    template <typename SampleType>
+    BENCHMARK_NOINLINE SampleType processSampleOutOfLine(SecondOrderNLfilter<SampleType>& filter, int channel, SampleType input)
+    {
+        return filter.processSample(channel, input);
+    }
+
+    /** The main filter's per-channel loop on a stereo block, as process()
+    runs it, with processSample() either inlined into the loop or called out
+    of line once per sample. */
+    template <typename SampleType, bool outOfLine>
+    double timeProcessSample(SaturationType saturation)
+    {
+        constexpr int numChannels = 2;
+
+        SecondOrderNLfilter<SampleType> filter;
+        juce::dsp::ProcessSpec spec{ sampleRate, (juce::uint32)blockSize, numChannels };
+        filter.prepare(spec);
+        filter.setFilterType(FilterType::lowPass2);
+        filter.setResonance(static_cast<SampleType>(0.7));
+        filter.setSaturationType(saturation);
+
+        juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+        fillWithNoise(buffer);
+
+        return time(numChannels, [&]
+        {
+            filter.updateCoefficients();
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* samples = buffer.getWritePointer(channel);
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    if constexpr (outOfLine)
+                        samples[i] = processSampleOutOfLine(filter, channel, samples[i]);
+                    else
+                        samples[i] = filter.processSample(channel, samples[i]);
+                }
+            }
+        });
+    }
+
+    /** Sixteen voices of the synth bank, each on its own buffer. */
+    template <typename SampleType>
+    double timeFilterBank()
+    {
+        constexpr int numVoices = 16;
+
+        FilterBank<SampleType, numVoices> bank;
+        juce::dsp::ProcessSpec spec{ sampleRate, (juce::uint32)blockSize, 1 };
+        bank.prepare(spec);
+        bank.setFilterType(FilterType::lowPass2);
+        bank.setSaturationType(SaturationType::nonlinear4);
+
+        for (int voice = 0; voice < numVoices; ++voice)
+        {
+            bank.setFrequency(voice, static_cast<SampleType>(200.0 + 500.0 * voice));
+            bank.setResonance(voice, static_cast<SampleType>(0.7));
+            bank.setVoiceActive(voice, true);
+        }
+
+        juce::AudioBuffer<SampleType> buffer(numVoices, blockSize);
+        fillWithNoise(buffer);
+
+        return time(numVoices, [&] { bank.process(buffer.getArrayOfWritePointers(), blockSize); });
+    }
+
+    /** The four-band split, saturating every band, on a stereo block. */
+    template <typename SampleType>
+    double timeMultiband()
+    {
+        constexpr int numChannels = 2;
+
+        MultibandSaturator<SampleType, 4> split;
+        juce::dsp::ProcessSpec spec{ sampleRate, (juce::uint32)blockSize, numChannels };
+        split.prepare(spec);
+        split.setNumBands(4);
+
+        for (int band = 0; band < 4; ++band)
+        {
+            split.setSaturationType(band, SaturationType::nonlinear4);
+            split.setDrive(band, static_cast<SampleType>(12.0));
+        }
+
+        juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+        juce::AudioBuffer<SampleType> input(numChannels, blockSize);
+        fillWithNoise(input);
+
+        return time(numChannels, [&]
+        {
+            buffer.makeCopyOf(input, true);
+            juce::dsp::AudioBlock<SampleType> block(buffer);
+            split.process(block);
+        });
+    }
+}
+
+//==============================================================================
+int main(int, char*[])
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    std::printf("%-20s %-8s %12s %12s\n", "kernel", "variant", "float ns", "double ns");
+
+    auto print = [](const char* name, KernelVariant variant, double floatNs, double doubleNs)
+    {
+        std::printf("%-20s %-8s %12.3f %12.3f\n", name, CpuDispatch::getName(variant), floatNs, doubleNs);
+    };
+
+    // The filter itself is not dispatched, so it is timed once.
+    print("Filter linear", KernelVariant::generic, timeFilter<float>(SaturationType::linear), timeFilter<double>(SaturationType::linear));
+    print("Filter NL1", KernelVariant::generic, timeFilter<float>(SaturationType::nonlinear1), timeFilter<double>(SaturationType::nonlinear1));
+    print("Filter NL4", KernelVariant::generic, timeFilter<float>(SaturationType::nonlinear4), timeFilter<double>(SaturationType::nonlinear4));
+
+    // The per-sample call that the header-defined kernels removed.
+    for (auto saturation : { SaturationType::linear, SaturationType::nonlinear4 })
+    {
+        const auto* name = saturation == SaturationType::linear ? "linear" : "NL4";
+
+        std::printf("processSample %-6s %-8s %12.3f %12.3f  (out of line)\n", name, "generic",
+                    timeProcessSample<float, true>(saturation), timeProcessSample<double, true>(saturation));
+        std::printf("processSample %-6s %-8s %12.3f %12.3f  (inline)\n", name, "generic",
+                    timeProcessSample<float, false>(saturation), timeProcessSample<double, false>(saturation));
+    }
+
+    for (auto variant : { KernelVariant::generic, KernelVariant::avx2, KernelVariant::avx512 })
+    {
+        if (! CpuDispatch::isSupported(variant))
+        {
+            std::printf("%-20s %-8s %12s %12s\n", "(all)", CpuDispatch::getName(variant), "-", "-");
+            continue;
+        }
+
+        // The processors take their variant in prepare().
+        CpuDispatch::setForcedVariant(variant);
+
+        print("FilterBank x16", variant, timeFilterBank<float>(), timeFilterBank<double>());
+        print("MultibandSaturator", variant, timeMultiband<float>(), timeMultiband<double>());
+    }
+
+    CpuDispatch::setForcedVariant(KernelVariant::automatic);
+
+    return 0;
+}
@@ -60,7 +60,7 @@ AutoComponentLookAndFeel::AutoComponentLookAndFeel()
   ==============================================================================
 */
 
-AutoComponent::AutoComponent(juce::AudioProcessor& p, APVTS& apvts, Lambda& onValueChange, TextFromVal& textFromValue, ValFromText& valueFromText)
+AutoComponent::AutoComponent(juce::AudioProcessor& p, APVTS& apvts, const juce::StringArray& excludedGroups, Lambda& onValueChange, TextFromVal& textFromValue, ValFromText& valueFromText)
 {
     auto addSlider = [=, &apvts](juce::AudioParameterFloat* param)
     {
@@ -79,6 +79,7 @@ AutoComponent::AutoComponent(juce::AudioProcessor& p, APVTS& apvts, Lambda& onVa
         newSlide->slider.setNumDecimalPlacesToDisplay(2);
         newSlide->slider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 16);
         newSlide->slider.onValueChange = onValueChange;
+        newSlide->slider.setLookAndFeel(&lookAndfeel);
 
         sliders.add(newSlide);
     };
@@ -93,6 +94,7 @@ AutoComponent::AutoComponent(juce::AudioProcessor& p, APVTS& apvts, Lambda& onVa
         newBox->box.addItemList(param->choices, 1);
         newBox->box.setSelectedItemIndex(0);
         newBox->box.onChange = onValueChange;
+        newBox->box.setLookAndFeel(&lookAndfeel);
 
         newBox->attachment.reset(new ComboBoxAttachment(apvts, param->paramID, newBox->box));
 
@@ -108,16 +110,29 @@ AutoComponent::AutoComponent(juce::AudioProcessor& p, APVTS& apvts, Lambda& onVa
         newButton->button.setButtonText(param->name);
         newButton->button.setClickingTogglesState(true);
         newButton->button.onStateChange = onValueChange;
+        newButton->button.setLookAndFeel(&lookAndfeel);
 
         newButton->attachment.reset(new ButtonAttachment(apvts, param->paramID, newButton->button));
 
         buttons.add(newButton);
     };
 
+    auto isExcluded = [&p, &excludedGroups](juce::AudioProcessorParameter* param)
+    {
+        for (auto* group : p.getParameterTree().getGroupsForParameter(param))
+            if (excludedGroups.contains(group->getID()))
+                return true;
+
+        return false;
+    };
+
     auto params = p.getParameters();
 
     for (auto* param : params)
     {
+        if (isExcluded(param))
+            continue;
+
         //======================================================================
         /** If = ParameterFloat, make new Rotary Slider with Attachment */
 
@@ -153,6 +168,20 @@ AutoComponent::AutoComponent(juce::AudioProcessor& p, APVTS& apvts, Lambda& onVa
 
 void AutoComponent::paint(juce::Graphics& g)
 {
+    g.drawImage(labels, getLocalBounds().toFloat());
+}
+
+void AutoComponent::renderLabels()
+{
+    const auto scale = juce::Component::getApproximateScaleFactorForComponent(this);
+
+    labels = juce::Image(juce::Image::ARGB,
+                         juce::jmax(1, juce::roundToInt(getWidth() * scale)),
+                         juce::jmax(1, juce::roundToInt(getHeight() * scale)), true);
+
+    juce::Graphics g(labels);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     //==========================================================================
     /** Paint Slider/Box name. */
 
@@ -170,23 +199,6 @@ void AutoComponent::paint(juce::Graphics& g)
 
     for (auto* b : boxes)
         paintName(b->box, b->box.getName());
-
-    //==========================================================================
-    /** Apply local Look and Feel. */
-
-    auto applyLookAndFeel = [this, &g](juce::Component& comp)
-    {
-        comp.setLookAndFeel(&lookAndfeel);
-    };
-
-    for (auto* s : sliders)
-        applyLookAndFeel(s->slider);
-
-    for (auto* b : boxes)
-        applyLookAndFeel(b->box);
-
-    for (auto* b : buttons)
-        applyLookAndFeel(b->button);
 }
 
 //==============================================================================
@@ -236,5 +248,8 @@ void AutoComponent::resized()
         x = b->button.getRight();
         first = false;
     }
+
+    // The names sit above the controls, so redraw them once they have moved.
+    renderLabels();
 }
 //==============================================================================
@@ -77,8 +77,9 @@ public:
     using TextFromVal = const std::function<juce::String(double)>;
     using ValFromText = const std::function<double(juce::String)>;
     //==========================================================================
-    /** Constructor. */
-    AutoComponent(juce::AudioProcessor& p, APVTS& apvts, Lambda& onValueChange = {}, TextFromVal& textFromValue = {}, ValFromText& valueFromText = {});
+    /** Constructor. Parameters in any of the excluded groups are left to
+    other components. */
+    AutoComponent(juce::AudioProcessor& p, APVTS& apvts, const juce::StringArray& excludedGroups = {}, Lambda& onValueChange = {}, TextFromVal& textFromValue = {}, ValFromText& valueFromText = {});
 
     //==========================================================================
     /** Component methods. */
@@ -86,10 +87,15 @@ public:
     void resized() override;
 
 private:
+    //==========================================================================
+    /** Draws the control names into an image, so paint() only blits it. */
+    void renderLabels();
+
     //==========================================================================
     /** Instantiate members. */
     //Lambda& lambda;
     AutoComponentLookAndFeel lookAndfeel;
+    juce::Image labels;
     juce::OwnedArray<SliderWithAttachment> sliders;
     juce::OwnedArray<BoxWithAttachment> boxes;
     juce::OwnedArray<ButtonWithAttachment> buttons;
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    EqualiserPanel.cpp
+    Created: 20 Oct 2026 4:58:02am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "EqualiserPanel.h"
+#include "../PluginParameters.h"
+
+/*
+  ==============================================================================
+
+    Equaliser Panel.
+
+  ==============================================================================
+*/
+
+EqualiserPanel::EqualiserPanel(APVTS& apvts)
+    :
+    state(apvts)
+{
+    for (int band = 0; band < Parameters::numBands; ++band)
+        bandList.addItem("Band " + juce::String(band + 1), band + 1);
+
+    bandList.onChange = [this] { showBand(bandList.getSelectedItemIndex()); };
+    enabledButton.setClickingTogglesState(true);
+
+    for (auto* slider : { &frequencySlider, &resonanceSlider, &gainSlider })
+    {
+        slider->setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+        slider->setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 16);
+        slider->setNumDecimalPlacesToDisplay(2);
+        slider->setLookAndFeel(&lookAndfeel);
+        addAndMakeVisible(*slider);
+    }
+
+    for (auto* box : { &bandList, &typeBox, &linearityBox })
+    {
+        box->setLookAndFeel(&lookAndfeel);
+        addAndMakeVisible(*box);
+    }
+
+    enabledButton.setLookAndFeel(&lookAndfeel);
+    addAndMakeVisible(enabledButton);
+
+    bandList.setSelectedItemIndex(0, juce::dontSendNotification);
+    showBand(0);
+}
+
+//==============================================================================
+void EqualiserPanel::showBand(int band)
+{
+    if (! juce::isPositiveAndBelow(band, Parameters::numBands))
+        return;
+
+    // The old attachments go first, so they cannot write the new band's
+    // values back to the old band's parameters.
+    enabledAttachment.reset();
+    frequencyAttachment.reset();
+    resonanceAttachment.reset();
+    gainAttachment.reset();
+    typeAttachment.reset();
+    linearityAttachment.reset();
+
+    auto fillChoices = [this, band](juce::ComboBox& box, const juce::String& setting)
+    {
+        box.clear(juce::dontSendNotification);
+
+        if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(state.getParameter(Parameters::getBandID(band, setting))))
+            box.addItemList(choice->choices, 1);
+    };
+
+    fillChoices(typeBox, "Type");
+    fillChoices(linearityBox, "Linearity");
+
+    enabledAttachment.reset(new ButtonAttachment(state, Parameters::getBandID(band, "Enabled"), enabledButton));
+    frequencyAttachment.reset(new SliderAttachment(state, Parameters::getBandID(band, "Frequency"), frequencySlider));
+    resonanceAttachment.reset(new SliderAttachment(state, Parameters::getBandID(band, "Resonance"), resonanceSlider));
+    gainAttachment.reset(new SliderAttachment(state, Parameters::getBandID(band, "Gain"), gainSlider));
+    typeAttachment.reset(new ComboBoxAttachment(state, Parameters::getBandID(band, "Type"), typeBox));
+    linearityAttachment.reset(new ComboBoxAttachment(state, Parameters::getBandID(band, "Linearity"), linearityBox));
+}
+
+//==============================================================================
+void EqualiserPanel::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::antiquewhite);
+    g.setFont(15.0f);
+    g.drawFittedText("Equaliser", getLocalBounds().removeFromTop(20), juce::Justification::centredLeft, 1);
+}
+
+void EqualiserPanel::resized()
+{
+    auto row = getLocalBounds().withTrimmedTop(20);
+    const auto lineHeight = 20;
+
+    bandList.setBounds(row.removeFromLeft(80).withSizeKeepingCentre(80, lineHeight));
+    row.removeFromLeft(5);
+    enabledButton.setBounds(row.removeFromLeft(40).withSizeKeepingCentre(40, lineHeight));
+    row.removeFromLeft(5);
+
+    for (auto* slider : { &frequencySlider, &resonanceSlider, &gainSlider })
+        slider->setBounds(row.removeFromLeft(90));
+
+    row.removeFromLeft(5);
+    typeBox.setBounds(row.removeFromLeft(70).withSizeKeepingCentre(70, lineHeight));
+    row.removeFromLeft(5);
+    linearityBox.setBounds(row.removeFromLeft(70).withSizeKeepingCentre(70, lineHeight));
+}
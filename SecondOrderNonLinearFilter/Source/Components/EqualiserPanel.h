@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    EqualiserPanel.h
+    Created: 20 Oct 2026 4:58:02am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef EQUALISERPANEL_H_INCLUDED
+#define EQUALISERPANEL_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AutoComponent.h"
+
+/*
+  ==============================================================================
+
+    Equaliser Panel.
+
+  ==============================================================================
+*/
+
+/** Controls for the equaliser bands, one band at a time. Picking a band from
+    the list attaches the controls to that band's parameters, so all of them
+    fit in a single row. */
+class EqualiserPanel : public juce::Component
+{
+public:
+    using APVTS = juce::AudioProcessorValueTreeState;
+    //==========================================================================
+    /** Constructor. */
+    EqualiserPanel(APVTS& apvts);
+
+    //==========================================================================
+    /** Component methods. */
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==========================================================================
+    /** Attaches the controls to the parameters of a band. */
+    void showBand(int band);
+
+    APVTS& state;
+    AutoComponentLookAndFeel lookAndfeel;
+
+    juce::ComboBox bandList;
+    juce::TextButton enabledButton{ "On" };
+    juce::Slider frequencySlider, resonanceSlider, gainSlider;
+    juce::ComboBox typeBox, linearityBox;
+
+    std::unique_ptr<ButtonAttachment> enabledAttachment;
+    std::unique_ptr<SliderAttachment> frequencyAttachment, resonanceAttachment, gainAttachment;
+    std::unique_ptr<ComboBoxAttachment> typeAttachment, linearityAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EqualiserPanel)
+};
+
+#endif //EQUALISERPANEL_H_INCLUDED
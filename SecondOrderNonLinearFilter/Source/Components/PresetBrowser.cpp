@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    PresetBrowser.cpp
+    Created: 20 Oct 2026 1:40:52am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "PresetBrowser.h"
+
+/*
+  ==============================================================================
+
+    Preset Browser.
+
+  ==============================================================================
+*/
+
+PresetBrowser::PresetBrowser(juce::AudioProcessor& p, PresetLibrary& library, std::function<int(const juce::String&)> savePreset)
+    :
+    audioProcessor(p),
+    presets(library),
+    save(std::move(savePreset))
+{
+    list.setEditableText(true);
+    list.setTextWhenNothingSelected("Presets");
+    list.onChange = [this]
+    {
+        const auto index = list.getSelectedItemIndex();
+
+        if (index >= 0)
+            audioProcessor.setCurrentProgram(index);
+    };
+
+    saveButton.onClick = [this]
+    {
+        const auto name = list.getText().trim();
+
+        if (name.isNotEmpty())
+            save(name);
+    };
+
+    addAndMakeVisible(list);
+    addAndMakeVisible(saveButton);
+
+    presets.addChangeListener(this);
+    presets.reloadIfChanged();
+    refresh();
+}
+
+PresetBrowser::~PresetBrowser()
+{
+    presets.removeChangeListener(this);
+}
+
+//==============================================================================
+void PresetBrowser::resized()
+{
+    auto bounds = getLocalBounds();
+
+    saveButton.setBounds(bounds.removeFromRight(50));
+    bounds.removeFromRight(5);
+    list.setBounds(bounds);
+}
+
+//==============================================================================
+void PresetBrowser::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    refresh();
+}
+
+void PresetBrowser::refresh()
+{
+    list.clear(juce::dontSendNotification);
+
+    const auto numPresets = presets.getNumPresets();
+
+    for (int index = 0; index < numPresets; ++index)
+        list.addItem(presets.getName(index), index + 1);
+
+    if (numPresets > 0)
+        list.setSelectedItemIndex(audioProcessor.getCurrentProgram(), juce::dontSendNotification);
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    PresetBrowser.h
+    Created: 20 Oct 2026 1:40:52am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PRESETBROWSER_H_INCLUDED
+#define PRESETBROWSER_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "../Modules/PresetLibrary.h"
+
+/*
+  ==============================================================================
+
+    Preset Browser.
+
+  ==============================================================================
+*/
+
+/** A list of the presets in the library, with a button to save the current
+    settings under the name typed into the list. Picking a preset switches
+    the processor's program; the list is refilled whenever the library
+    changes, including saves made from other instances. */
+class PresetBrowser : public juce::Component, private juce::ChangeListener
+{
+public:
+    //==========================================================================
+    /** Constructor. */
+    PresetBrowser(juce::AudioProcessor& p, PresetLibrary& library, std::function<int(const juce::String&)> savePreset);
+
+    /** Destructor. */
+    ~PresetBrowser() override;
+
+    //==========================================================================
+    /** Component methods. */
+    void resized() override;
+
+private:
+    //==========================================================================
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    /** Refills the list from the library. */
+    void refresh();
+
+    juce::AudioProcessor& audioProcessor;
+    PresetLibrary& presets;
+    std::function<int(const juce::String&)> save;
+
+    juce::ComboBox list;
+    juce::TextButton saveButton{ "Save" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBrowser)
+};
+
+#endif //PRESETBROWSER_H_INCLUDED
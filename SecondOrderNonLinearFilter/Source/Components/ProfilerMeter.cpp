@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    ProfilerMeter.cpp
+    Created: 19 Oct 2026 11:02:36pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "ProfilerMeter.h"
+
+#if NLFILTER_PROFILING
+
+/*
+  ==============================================================================
+
+    Profiler Meter.
+
+  ==============================================================================
+*/
+
+ProfilerMeter::ProfilerMeter(std::function<StageProfiler&()> getProfiler)
+    :
+    profiler(std::move(getProfiler))
+{
+    setOpaque(false);
+    startTimerHz(4);
+}
+
+ProfilerMeter::~ProfilerMeter()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void ProfilerMeter::paint(juce::Graphics& g)
+{
+    const auto rowHeight = getHeight() / (StageProfiler::numStages + 1);
+    const auto columnWidth = getWidth() / 5;
+
+    auto drawRow = [&](int row, const juce::String (&cells)[5])
+    {
+        for (int column = 0; column < 5; ++column)
+        {
+            juce::Rectangle<int> cell(column * columnWidth, row * rowHeight, columnWidth, rowHeight);
+            g.drawText(cells[column], cell, column == 0 ? juce::Justification::centredLeft : juce::Justification::centredRight);
+        }
+    };
+
+    g.setFont(12.0f);
+    g.setColour(juce::Colours::wheat);
+    drawRow(0, { "Stage", "Mean us", "p99 us", "Max us", "% Budget" });
+
+    g.setColour(juce::Colours::antiquewhite);
+
+    for (int stage = 0; stage < StageProfiler::numStages; ++stage)
+    {
+        const auto& s = stats[(size_t)stage];
+
+        drawRow(stage + 1, { StageProfiler::getStageName(stage),
+                             juce::String(s.meanMicroseconds, 1),
+                             juce::String(s.p99Microseconds, 1),
+                             juce::String(s.maxMicroseconds, 1),
+                             juce::String(s.budgetPercent, 2) });
+    }
+}
+
+void ProfilerMeter::mouseDown(const juce::MouseEvent&)
+{
+    profiler().reset();
+}
+
+//==============================================================================
+void ProfilerMeter::timerCallback()
+{
+    auto& p = profiler();
+
+    for (int stage = 0; stage < StageProfiler::numStages; ++stage)
+        stats[(size_t)stage] = p.getStatistics(stage);
+
+    repaint();
+}
+
+#endif //NLFILTER_PROFILING
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ProfilerMeter.h
+    Created: 19 Oct 2026 11:02:36pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PROFILERMETER_H_INCLUDED
+#define PROFILERMETER_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "../Modules/StageProfiler.h"
+
+#if NLFILTER_PROFILING
+
+/*
+  ==============================================================================
+
+    Profiler Meter.
+
+  ==============================================================================
+*/
+
+/** A table of the per-stage timings, refreshed a few times a second. The
+    percentages are of the real-time budget of each block. Click to reset. */
+class ProfilerMeter : public juce::Component, private juce::Timer
+{
+public:
+    //==========================================================================
+    /** Constructor. */
+    explicit ProfilerMeter(std::function<StageProfiler&()> getProfiler);
+
+    /** Destructor. */
+    ~ProfilerMeter() override;
+
+    /** Height needed to show every stage. */
+    static constexpr int preferredHeight = (StageProfiler::numStages + 1) * 14;
+
+    //==========================================================================
+    /** Component methods. */
+    void paint(juce::Graphics& g) override;
+    void mouseDown(const juce::MouseEvent& event) override;
+
+private:
+    //==========================================================================
+    void timerCallback() override;
+
+    std::function<StageProfiler&()> profiler;
+    std::array<StageProfiler::Statistics, (size_t)StageProfiler::numStages> stats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerMeter)
+};
+
+#endif //NLFILTER_PROFILING
+
+#endif //PROFILERMETER_H_INCLUDED
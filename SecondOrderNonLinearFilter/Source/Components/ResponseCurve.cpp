@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 19 Oct 2026 9:41:07pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+#include "../Modules/SecondOrderNLfilter.h"
+#include "../PluginParameters.h"
+
+namespace
+{
+    /** Parameters that change the response. */
+    juce::StringArray getResponseIDs()
+    {
+        juce::StringArray ids{ "frequencyID", "resonanceID", "gainID", "typeID", "osID" };
+
+        for (int band = 0; band < Parameters::numBands; ++band)
+            for (auto* setting : { "Enabled", "Frequency", "Resonance", "Gain", "Type" })
+                ids.add(Parameters::getBandID(band, setting));
+
+        return ids;
+    }
+}
+
+/*
+  ==============================================================================
+
+    Response Curve.
+
+  ==============================================================================
+*/
+
+ResponseCurve::ResponseCurve(const std::atomic<double>& preparedSampleRate, APVTS& apvts)
+    :
+    juce::Thread("Response Curve"),
+    preparedRate(preparedSampleRate),
+    state(apvts)
+{
+    const auto ratio = std::log(maxFrequency / minFrequency);
+
+    for (int i = 0; i < numPoints; ++i)
+        frequencies[(size_t)i] = minFrequency * std::exp(ratio * i / (numPoints - 1));
+
+    computed.fill(0.0f);
+    published.fill(0.0f);
+    drawn.fill(0.0f);
+
+    for (auto& id : getResponseIDs())
+        state.addParameterListener(id, this);
+
+    setOpaque(false);
+    startThread();
+}
+
+ResponseCurve::~ResponseCurve()
+{
+    for (auto& id : getResponseIDs())
+        state.removeParameterListener(id, this);
+
+    signalThreadShouldExit();
+    notify();
+    stopThread(1000);
+    cancelPendingUpdate();
+}
+
+//==============================================================================
+void ResponseCurve::handleAsyncUpdate()
+{
+    const auto version = publishedVersion.load(std::memory_order_acquire);
+
+    if (version == drawnVersion)
+        return;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(publishLock);
+        drawn = published;
+    }
+
+    drawnVersion = version;
+    updatePath();
+    repaint();
+}
+
+//==============================================================================
+void ResponseCurve::paint(juce::Graphics& g)
+{
+    // Drawn over the spectrum analyser, so the background is left clear.
+    const auto bounds = getLocalBounds().toFloat();
+
+    // Decades and 0 dB.
+    g.setColour(juce::Colours::lightslategrey.withAlpha(0.5f));
+
+    for (auto hz : { 100.0, 1000.0, 10000.0 })
+    {
+        const auto x = bounds.getWidth() * (float)(std::log(hz / minFrequency) / std::log(maxFrequency / minFrequency));
+        g.drawVerticalLine(juce::roundToInt(x), bounds.getY(), bounds.getBottom());
+    }
+
+    g.drawHorizontalLine(juce::roundToInt(bounds.getCentreY()), bounds.getX(), bounds.getRight());
+
+    g.setColour(juce::Colours::wheat);
+    g.strokePath(curve, juce::PathStrokeType(2.0f));
+}
+
+void ResponseCurve::resized()
+{
+    updatePath();
+}
+
+//==============================================================================
+void ResponseCurve::run()
+{
+    uint32_t computedVersion = 0;
+
+    while (!threadShouldExit())
+    {
+        // The host may change rate without touching any parameter.
+        const auto rate = preparedRate.load(std::memory_order_acquire);
+
+        if (rate != sampleRate)
+        {
+            sampleRate = rate;
+            requestedVersion.fetch_add(1, std::memory_order_release);
+        }
+
+        const auto version = requestedVersion.load(std::memory_order_acquire);
+
+        if (version == computedVersion)
+        {
+            wait(pollMilliseconds);
+            continue;
+        }
+
+        computeResponse();
+        computedVersion = version;
+
+        {
+            const juce::SpinLock::ScopedLockType lock(publishLock);
+            published = computed;
+        }
+
+        publishedVersion.store(version, std::memory_order_release);
+        triggerAsyncUpdate();
+    }
+}
+
+void ResponseCurve::parameterChanged(const juce::String&, float)
+{
+    // No notify(): signalling the thread's event takes a lock, and this may be
+    // the audio thread. The thread picks the change up on its next poll.
+    requestedVersion.fetch_add(1, std::memory_order_release);
+}
+
+void ResponseCurve::computeResponse()
+{
+    auto rate = sampleRate;
+
+    if (rate <= 0.0)
+        rate = 48000.0;
+
+    const auto type = static_cast<FilterType>(juce::roundToInt(state.getRawParameterValue("typeID")->load()));
+    const auto hz = static_cast<double>(state.getRawParameterValue("frequencyID")->load());
+    const auto q = static_cast<double>(state.getRawParameterValue("resonanceID")->load());
+    const auto g = static_cast<double>(state.getRawParameterValue("gainID")->load());
+    const auto factor = 1 << juce::roundToInt(state.getRawParameterValue("osID")->load());
+
+    // The wrapper designs at the base rate for hz / factor and runs the result
+    // at the oversampled rate; do the same here.
+    const auto osRate = rate * factor;
+
+    if (osRate != gridRate)
+    {
+        for (size_t i = 0; i < (size_t)numPoints; ++i)
+        {
+            const auto w = juce::MathConstants<double>::twoPi * frequencies[i] / osRate;
+            cosW[i] = std::cos(w);
+            cos2W[i] = std::cos(2.0 * w);
+        }
+
+        gridRate = osRate;
+    }
+
+    // The responses of the filter and of the enabled equaliser bands after
+    // it add up in decibels.
+    computed.fill(0.0f);
+
+    auto addResponse = [this](const BiquadCoefficients<double>& c)
+    {
+        // |B|^2 and |A|^2 are both of the form p + q.cos(w) + r.cos(2w), with
+        // A(z) = 1 - a1.z^-1 - a2.z^-2 in the filter's sign convention.
+        const auto nP = c.b0 * c.b0 + c.b1 * c.b1 + c.b2 * c.b2;
+        const auto nQ = 2.0 * (c.b0 * c.b1 + c.b1 * c.b2);
+        const auto nR = 2.0 * c.b0 * c.b2;
+        const auto dP = 1.0 + c.a1 * c.a1 + c.a2 * c.a2;
+        const auto dQ = 2.0 * (c.a1 * c.a2 - c.a1);
+        const auto dR = -2.0 * c.a2;
+
+        for (size_t i = 0; i < (size_t)numPoints; ++i)
+        {
+            const auto num = nP + nQ * cosW[i] + nR * cos2W[i];
+            const auto den = dP + dQ * cosW[i] + dR * cos2W[i];
+
+            computed[i] += (float)(10.0 * std::log10(juce::jmax(num / den, 1.0e-12)));
+        }
+    };
+
+    addResponse(SecondOrderNLfilter<double>::design(type, hz / factor, q, g, rate));
+
+    auto getBandValue = [this](int band, const char* setting)
+    {
+        return static_cast<double>(state.getRawParameterValue(Parameters::getBandID(band, setting))->load());
+    };
+
+    for (int band = 0; band < Parameters::numBands; ++band)
+    {
+        if (getBandValue(band, "Enabled") < 0.5)
+            continue;
+
+        const auto bandType = static_cast<FilterType>(juce::roundToInt(getBandValue(band, "Type")));
+
+        addResponse(SecondOrderNLfilter<double>::design(bandType, getBandValue(band, "Frequency") / factor,
+                                                        getBandValue(band, "Resonance"), getBandValue(band, "Gain"), rate));
+    }
+}
+
+void ResponseCurve::updatePath()
+{
+    const auto bounds = getLocalBounds().toFloat().reduced(0.0f, 2.0f);
+
+    curve.clear();
+
+    if (bounds.isEmpty())
+        return;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto x = bounds.getX() + bounds.getWidth() * i / (float)(numPoints - 1);
+        const auto dB = juce::jlimit(minDecibels, maxDecibels, drawn[(size_t)i]);
+        const auto y = juce::jmap(dB, minDecibels, maxDecibels, bounds.getBottom(), bounds.getY());
+
+        if (i == 0)
+            curve.startNewSubPath(x, y);
+        else
+            curve.lineTo(x, y);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 19 Oct 2026 9:41:07pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef RESPONSECURVE_H_INCLUDED
+#define RESPONSECURVE_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/*
+  ==============================================================================
+
+    Response Curve.
+
+  ==============================================================================
+*/
+
+/** Draws the magnitude response of the filter for the current parameters.
+
+    The response is evaluated on a background thread over a log-spaced
+    frequency grid, using the same coefficient design as the filter. Each
+    parameter change bumps an atomic version number and nothing else, as
+    automation calls the listener on the audio thread. The thread polls the
+    version and the processor's atomic sample rate with a short timed wait,
+    only recomputes when either has moved on,
+    and posts a message to rebuild the path and repaint once a newer response
+    has been published. Nothing runs on the message thread while the
+    parameters are still.
+*/
+class ResponseCurve : public juce::Component,
+                      private juce::Thread,
+                      private juce::AsyncUpdater,
+                      private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    using APVTS = juce::AudioProcessorValueTreeState;
+    //==========================================================================
+    /** Constructor. */
+    ResponseCurve(const std::atomic<double>& preparedSampleRate, APVTS& apvts);
+
+    /** Destructor. */
+    ~ResponseCurve() override;
+
+    //==========================================================================
+    /** Component methods. */
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==========================================================================
+    /** Background thread. */
+    void run() override;
+
+    /** Picks up the newly published response. */
+    void handleAsyncUpdate() override;
+
+    /** Parameter listener callback, called from whichever thread changes the
+    parameter. Wait-free, so it is safe on the audio thread. */
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    /** Evaluates |H(e^jw)| in decibels over the grid for the current settings. */
+    void computeResponse();
+
+    /** Rebuilds the curve from the last published response. */
+    void updatePath();
+
+    //==========================================================================
+    const std::atomic<double>& preparedRate;
+    APVTS& state;
+
+    //==========================================================================
+    static constexpr int numPoints = 256;
+    static constexpr double minFrequency = 20.0, maxFrequency = 20000.0;
+    static constexpr float minDecibels = -24.0f, maxDecibels = 24.0f;
+
+    /** Grid, and cos(w) and cos(2w) at the rate it was last built for. */
+    std::array<double, numPoints> frequencies, cosW, cos2W;
+    double gridRate = 0.0;
+
+    /** Responses, in decibels. */
+    std::array<float, numPoints> computed, published, drawn;
+    juce::SpinLock publishLock;
+
+    //==========================================================================
+    /** Parameter versions. */
+    std::atomic<uint32_t> requestedVersion{ 1 }, publishedVersion{ 0 };
+    uint32_t drawnVersion = 0;
+    double sampleRate = 0.0;
+
+    /** How often the thread checks for a change of parameters or sample rate. */
+    static constexpr int pollMilliseconds = 30;
+
+    juce::Path curve;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResponseCurve)
+};
+
+#endif //RESPONSECURVE_H_INCLUDED
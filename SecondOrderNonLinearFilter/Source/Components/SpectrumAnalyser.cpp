@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+    Created: 19 Oct 2026 10:18:52pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+
+/*
+  ==============================================================================
+
+    Spectrum Analyser.
+
+  ==============================================================================
+*/
+
+SpectrumAnalyser::SpectrumAnalyser(const std::atomic<double>& preparedSampleRate, AnalyserFifo& inputFifo, AnalyserFifo& outputFifo)
+    :
+    preparedRate(preparedSampleRate),
+    input(inputFifo),
+    output(outputFifo)
+{
+    for (auto* trace : { &input, &output })
+    {
+        trace->history.fill(0.0f);
+        trace->levels.fill(minDecibels);
+        trace->fifo.setActive(true);
+    }
+
+    setOpaque(false);
+    startTimerHz(refreshRateHz);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    stopTimer();
+
+    input.fifo.setActive(false);
+    output.fifo.setActive(false);
+}
+
+//==============================================================================
+void SpectrumAnalyser::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::darkslategrey);
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+
+    g.setColour(juce::Colours::lightslategrey.withAlpha(0.6f));
+    g.fillPath(input.path);
+
+    g.setColour(juce::Colours::antiquewhite.withAlpha(0.5f));
+    g.fillPath(output.path);
+}
+
+void SpectrumAnalyser::resized()
+{
+    updatePath(input);
+    updatePath(output);
+}
+
+//==============================================================================
+void SpectrumAnalyser::timerCallback()
+{
+    if (isIdle)
+    {
+        // Evaluated for both, so neither flag is left raised.
+        const auto inputWoken = input.fifo.checkAndClearWakeUp();
+        const auto outputWoken = output.fifo.checkAndClearWakeUp();
+
+        if (! (inputWoken || outputWoken))
+            return;
+
+        isIdle = false;
+        startTimerHz(refreshRateHz);
+    }
+
+    auto needsRepaint = false;
+
+    for (auto* trace : { &input, &output })
+    {
+        if (pull(*trace))
+            analyse(*trace);
+
+        else if (!release(*trace))
+            continue;
+
+        updatePath(*trace);
+        needsRepaint = true;
+    }
+
+    if (needsRepaint)
+    {
+        repaint();
+        return;
+    }
+
+    // Nothing new and nothing left to decay: only poll for the next push.
+    isIdle = true;
+    input.fifo.requestWakeUp();
+    output.fifo.requestWakeUp();
+    startTimerHz(idleRateHz);
+}
+
+bool SpectrumAnalyser::pull(Trace& trace)
+{
+    auto& history = trace.history;
+    auto total = 0;
+
+    // Keep a sliding window of the last fftSize samples.
+    while (auto n = trace.fifo.pull(scratch.data(), fftSize))
+    {
+        std::move(history.begin() + n, history.end(), history.begin());
+        std::copy_n(scratch.begin(), n, history.end() - n);
+        total += n;
+    }
+
+    return total > 0;
+}
+
+void SpectrumAnalyser::analyse(Trace& trace)
+{
+    std::copy(trace.history.begin(), trace.history.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    window.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    // Full scale sine = 0 dB: 2/N for the single-sided spectrum, and 2 for
+    // the coherent gain of the Hann window.
+    const auto scale = 4.0f / fftSize;
+
+    for (size_t k = 0; k < (size_t)numBins; ++k)
+    {
+        const auto dB = juce::Decibels::gainToDecibels(fftData[k] * scale, minDecibels);
+        auto& level = trace.levels[k];
+
+        level = juce::jmax(dB, level - releaseDecibels);
+    }
+}
+
+bool SpectrumAnalyser::release(Trace& trace)
+{
+    auto isAboveFloor = false;
+
+    for (auto& level : trace.levels)
+    {
+        level = juce::jmax(minDecibels, level - releaseDecibels);
+        isAboveFloor = isAboveFloor || level > minDecibels;
+    }
+
+    return isAboveFloor;
+}
+
+void SpectrumAnalyser::updatePath(Trace& trace)
+{
+    const auto bounds = getLocalBounds().toFloat().reduced(0.0f, 2.0f);
+    auto& path = trace.path;
+
+    path.clear();
+
+    if (bounds.isEmpty())
+        return;
+
+    auto sampleRate = preparedRate.load(std::memory_order_acquire);
+
+    if (sampleRate <= 0.0)
+        sampleRate = 48000.0;
+
+    const auto ratio = std::log(maxFrequency / minFrequency);
+    const auto binsPerHz = fftSize / sampleRate;
+
+    path.startNewSubPath(bounds.getX(), bounds.getBottom());
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto hz = minFrequency * std::exp(ratio * i / (numPoints - 1));
+        const auto bin = juce::jlimit(0.0, (double)(numBins - 1), hz * binsPerHz);
+        const auto k = juce::jmin((int)bin, numBins - 2);
+        const auto frac = (float)(bin - k);
+
+        const auto dB = trace.levels[(size_t)k] + frac * (trace.levels[(size_t)k + 1] - trace.levels[(size_t)k]);
+        const auto x = bounds.getX() + bounds.getWidth() * i / (float)(numPoints - 1);
+        const auto y = juce::jmap(dB, minDecibels, maxDecibels, bounds.getBottom(), bounds.getY());
+
+        path.lineTo(x, y);
+    }
+
+    path.lineTo(bounds.getRight(), bounds.getBottom());
+    path.closeSubPath();
+}
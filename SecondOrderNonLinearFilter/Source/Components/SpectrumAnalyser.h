@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 19 Oct 2026 10:18:52pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SPECTRUMANALYSER_H_INCLUDED
+#define SPECTRUMANALYSER_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "../Modules/AnalyserFifo.h"
+
+/*
+  ==============================================================================
+
+    Spectrum Analyser.
+
+  ==============================================================================
+*/
+
+/** Draws the spectrum before and after the filter, over the same axis as the
+    response curve.
+
+    Samples arrive through the processor's AnalyserFifos, which only collect
+    while this component exists. The FFT, smoothing and path building all run
+    on the message thread, at the timer rate rather than the audio rate. Once
+    no samples are arriving and both traces have fallen to the floor, the
+    timer drops to a low rate that only polls the fifos' wake-up flags, and
+    goes back to the full rate when either is raised.
+*/
+class SpectrumAnalyser : public juce::Component,
+                         private juce::Timer
+{
+public:
+    //==========================================================================
+    /** Constructor. */
+    SpectrumAnalyser(const std::atomic<double>& preparedSampleRate, AnalyserFifo& input, AnalyserFifo& output);
+
+    /** Destructor. */
+    ~SpectrumAnalyser() override;
+
+    //==========================================================================
+    /** Component methods. */
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==========================================================================
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = fftSize / 2 + 1;
+    static constexpr int numPoints = 256;
+    static constexpr double minFrequency = 20.0, maxFrequency = 20000.0;
+    static constexpr float minDecibels = -96.0f, maxDecibels = 0.0f;
+    static constexpr float releaseDecibels = 1.0f;
+    static constexpr int refreshRateHz = 30, idleRateHz = 4;
+
+    /** One analysed signal. */
+    struct Trace
+    {
+        explicit Trace(AnalyserFifo& f) : fifo(f) {}
+
+        AnalyserFifo& fifo;
+        std::array<float, (size_t)fftSize> history;
+        std::array<float, (size_t)numBins> levels;
+        juce::Path path;
+    };
+
+    //==========================================================================
+    void timerCallback() override;
+
+    /** Reads any new samples, and returns true if there were some. */
+    bool pull(Trace& trace);
+
+    /** Transforms the latest window and folds it into the smoothed levels. */
+    void analyse(Trace& trace);
+
+    /** Decays the smoothed levels towards the floor. Returns true if any
+    level is still above it. */
+    bool release(Trace& trace);
+
+    /** Rebuilds the path of a trace from its smoothed levels. */
+    void updatePath(Trace& trace);
+
+    //==========================================================================
+    const std::atomic<double>& preparedRate;
+
+    juce::dsp::FFT fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> window{ (size_t)fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::array<float, (size_t)(2 * fftSize)> fftData;
+    std::array<float, (size_t)fftSize> scratch;
+
+    Trace input, output;
+    bool isIdle = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyser)
+};
+
+#endif //SPECTRUMANALYSER_H_INCLUDED
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    SplitPanel.cpp
+    Created: 20 Oct 2026 6:12:40am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "SplitPanel.h"
+#include "../PluginParameters.h"
+
+/*
+  ==============================================================================
+
+    Split Panel.
+
+  ==============================================================================
+*/
+
+SplitPanel::SplitPanel(APVTS& apvts)
+    :
+    state(apvts)
+{
+    for (int band = 0; band < Parameters::numSplits; ++band)
+        bandList.addItem("Band " + juce::String(band + 1), band + 1);
+
+    bandList.onChange = [this] { showBand(bandList.getSelectedItemIndex()); };
+
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(state.getParameter("splitID")))
+        splitBox.addItemList(choice->choices, 1);
+
+    splitAttachment.reset(new ComboBoxAttachment(state, "splitID", splitBox));
+
+    for (auto* slider : { &crossoverSlider, &driveSlider })
+    {
+        slider->setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+        slider->setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 16);
+        slider->setNumDecimalPlacesToDisplay(2);
+        slider->setLookAndFeel(&lookAndfeel);
+        addAndMakeVisible(*slider);
+    }
+
+    for (auto* box : { &splitBox, &bandList, &linearityBox })
+    {
+        box->setLookAndFeel(&lookAndfeel);
+        addAndMakeVisible(*box);
+    }
+
+    bandList.setSelectedItemIndex(0, juce::dontSendNotification);
+    showBand(0);
+}
+
+//==============================================================================
+void SplitPanel::showBand(int band)
+{
+    if (! juce::isPositiveAndBelow(band, Parameters::numSplits))
+        return;
+
+    // The old attachments go first, so they cannot write the new band's
+    // values back to the old band's parameters.
+    crossoverAttachment.reset();
+    driveAttachment.reset();
+    linearityAttachment.reset();
+
+    linearityBox.clear(juce::dontSendNotification);
+
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(state.getParameter(Parameters::getSplitID(band, "Linearity"))))
+        linearityBox.addItemList(choice->choices, 1);
+
+    const auto hasCrossover = band < Parameters::numSplits - 1;
+    crossoverSlider.setEnabled(hasCrossover);
+
+    if (hasCrossover)
+        crossoverAttachment.reset(new SliderAttachment(state, Parameters::getSplitID(band, "Crossover"), crossoverSlider));
+
+    driveAttachment.reset(new SliderAttachment(state, Parameters::getSplitID(band, "Drive"), driveSlider));
+    linearityAttachment.reset(new ComboBoxAttachment(state, Parameters::getSplitID(band, "Linearity"), linearityBox));
+}
+
+//==============================================================================
+void SplitPanel::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::antiquewhite);
+    g.setFont(15.0f);
+    g.drawFittedText("Split", getLocalBounds().removeFromTop(20), juce::Justification::centredLeft, 1);
+}
+
+void SplitPanel::resized()
+{
+    auto row = getLocalBounds().withTrimmedTop(20);
+    const auto lineHeight = 20;
+
+    splitBox.setBounds(row.removeFromLeft(70).withSizeKeepingCentre(70, lineHeight));
+    row.removeFromLeft(5);
+    bandList.setBounds(row.removeFromLeft(80).withSizeKeepingCentre(80, lineHeight));
+    row.removeFromLeft(5);
+
+    for (auto* slider : { &crossoverSlider, &driveSlider })
+        slider->setBounds(row.removeFromLeft(90));
+
+    row.removeFromLeft(5);
+    linearityBox.setBounds(row.removeFromLeft(70).withSizeKeepingCentre(70, lineHeight));
+}
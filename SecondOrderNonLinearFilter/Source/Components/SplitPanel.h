@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    SplitPanel.h
+    Created: 20 Oct 2026 6:12:40am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SPLITPANEL_H_INCLUDED
+#define SPLITPANEL_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AutoComponent.h"
+
+/*
+  ==============================================================================
+
+    Split Panel.
+
+  ==============================================================================
+*/
+
+/** Controls for the multiband split: the number of bands, and the settings
+    of one band at a time, as in EqualiserPanel. The crossover shown is the
+    one above the band; the top band has none. */
+class SplitPanel : public juce::Component
+{
+public:
+    using APVTS = juce::AudioProcessorValueTreeState;
+    //==========================================================================
+    /** Constructor. */
+    SplitPanel(APVTS& apvts);
+
+    //==========================================================================
+    /** Component methods. */
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==========================================================================
+    /** Attaches the controls to the parameters of a band. */
+    void showBand(int band);
+
+    APVTS& state;
+    AutoComponentLookAndFeel lookAndfeel;
+
+    juce::ComboBox splitBox, bandList;
+    juce::Slider crossoverSlider, driveSlider;
+    juce::ComboBox linearityBox;
+
+    std::unique_ptr<ComboBoxAttachment> splitAttachment;
+    std::unique_ptr<SliderAttachment> crossoverAttachment, driveAttachment;
+    std::unique_ptr<ComboBoxAttachment> linearityAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SplitPanel)
+};
+
+#endif //SPLITPANEL_H_INCLUDED
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    AnalyserFifo.cpp
+    Created: 19 Oct 2026 10:18:52pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "AnalyserFifo.h"
+
+AnalyserFifo::AnalyserFifo()
+{
+    ring.resize((size_t)capacity, 0.0f);
+}
+
+//==============================================================================
+void AnalyserFifo::setActive(bool shouldBeActive) noexcept
+{
+    // The producer does not write while inactive, so the consumer can drop
+    // the stale samples itself before switching back on.
+    if (shouldBeActive)
+        fifo.finishedRead(fifo.getNumReady());
+
+    active.store(shouldBeActive, std::memory_order_relaxed);
+    wakeRequested.store(false, std::memory_order_relaxed);
+    woken.store(false, std::memory_order_relaxed);
+}
+
+//==============================================================================
+template <typename SampleType>
+void AnalyserFifo::push(const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    if (!active.load(std::memory_order_relaxed))
+        return;
+
+    const auto numChannels = buffer.getNumChannels();
+
+    if (numChannels == 0)
+        return;
+
+    const auto scale = static_cast<SampleType>(1.0 / numChannels);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(buffer.getNumSamples(), start1, size1, start2, size2);
+
+    auto downmix = [&](int destination, int numSamples, int sourceOffset)
+    {
+        auto* dst = ring.data() + destination;
+
+        const auto* first = buffer.getReadPointer(0) + sourceOffset;
+
+        for (int i = 0; i < numSamples; ++i)
+            dst[i] = static_cast<float>(first[i] * scale);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+        {
+            const auto* src = buffer.getReadPointer(ch) + sourceOffset;
+
+            for (int i = 0; i < numSamples; ++i)
+                dst[i] += static_cast<float>(src[i] * scale);
+        }
+    };
+
+    downmix(start1, size1, 0);
+    downmix(start2, size2, size1);
+
+    fifo.finishedWrite(size1 + size2);
+
+    // Only a flag, for the consumer to poll; posting a message from here
+    // would lock and allocate on the audio thread.
+    if (wakeRequested.load(std::memory_order_relaxed) && wakeRequested.exchange(false, std::memory_order_acq_rel))
+        woken.store(true, std::memory_order_release);
+}
+
+int AnalyserFifo::pull(float* destination, int maxSamples) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(maxSamples, start1, size1, start2, size2);
+
+    std::copy_n(ring.data() + start1, size1, destination);
+    std::copy_n(ring.data() + start2, size2, destination + size1);
+
+    fifo.finishedRead(size1 + size2);
+
+    return size1 + size2;
+}
+
+template void AnalyserFifo::push<float>(const juce::AudioBuffer<float>& buffer) noexcept;
+template void AnalyserFifo::push<double>(const juce::AudioBuffer<double>& buffer) noexcept;
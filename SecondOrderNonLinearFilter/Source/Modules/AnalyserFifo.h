@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    AnalyserFifo.h
+    Created: 19 Oct 2026 10:18:52pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef ANALYSERFIFO_H_INCLUDED
+#define ANALYSERFIFO_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** A single-producer, single-consumer ring of mono samples, from the audio
+    thread to the editor.
+
+    The audio thread downmixes each block into the ring without locking or
+    allocating; when the ring is full the rest of the block is dropped. While
+    the analyser is inactive push() returns straight away, so there is no
+    cost at all while the editor is closed.
+
+    A consumer that has stopped reading can ask to be woken: the next push()
+    then raises a flag, which the consumer polls at whatever rate it likes.
+    Nothing is sent from the audio thread.
+*/
+class AnalyserFifo
+{
+public:
+    //==========================================================================
+    /** Constructor. */
+    AnalyserFifo();
+
+    //==========================================================================
+    /** Starts or stops collecting samples. Call this from the consumer's
+    thread; any samples left over from the last time are discarded. */
+    void setActive(bool shouldBeActive) noexcept;
+
+    /** Returns true while samples are being collected. */
+    bool isActive() const noexcept { return active.load(std::memory_order_relaxed); }
+
+    /** Has the next push() raise the wake-up flag. Consumer thread only. */
+    void requestWakeUp() noexcept { wakeRequested.store(true, std::memory_order_release); }
+
+    /** Returns true, and clears the flag, if samples have been pushed since
+    the last requestWakeUp(). Consumer thread only. */
+    bool checkAndClearWakeUp() noexcept { return woken.exchange(false, std::memory_order_acq_rel); }
+
+    //==========================================================================
+    /** Pushes the average of every channel. Audio thread only. */
+    template <typename SampleType>
+    void push(const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    /** Pops up to maxSamples into destination, and returns how many were
+    read. Consumer thread only. */
+    int pull(float* destination, int maxSamples) noexcept;
+
+private:
+    //==========================================================================
+    static constexpr int capacity = 1 << 15;
+
+    juce::AbstractFifo fifo{ capacity };
+    std::vector<float> ring;
+
+    std::atomic<bool> active{ false }, wakeRequested{ false }, woken{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyserFifo)
+};
+
+#endif //ANALYSERFIFO_H_INCLUDED
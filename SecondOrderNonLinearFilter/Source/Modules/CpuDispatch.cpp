@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    CpuDispatch.cpp
+    Created: 20 Oct 2026 5:47:19am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "CpuDispatch.h"
+
+std::atomic<int> CpuDispatch::forcedVariant{ (int)KernelVariant::automatic };
+
+//==============================================================================
+KernelVariant CpuDispatch::getVariant() noexcept
+{
+    auto variant = static_cast<KernelVariant>(forcedVariant.load(std::memory_order_relaxed));
+
+    if (variant == KernelVariant::automatic)
+        variant = getEnvironmentVariant();
+
+    if (variant == KernelVariant::automatic)
+        return getBestVariant();
+
+    // A forced variant the CPU cannot run steps down to one it can.
+    while (! isSupported(variant))
+        variant = static_cast<KernelVariant>((int)variant - 1);
+
+    return variant;
+}
+
+KernelVariant CpuDispatch::getBestVariant() noexcept
+{
+    static const auto best = []
+    {
+        for (auto variant : { KernelVariant::avx512, KernelVariant::avx2 })
+            if (isSupported(variant))
+                return variant;
+
+        return KernelVariant::generic;
+    }();
+
+    return best;
+}
+
+bool CpuDispatch::isSupported(KernelVariant variant) noexcept
+{
+    switch (variant)
+    {
+    case KernelVariant::generic:
+        return true;
+#if NLFILTER_CPU_DISPATCH
+    case KernelVariant::avx2:
+        return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+    case KernelVariant::avx512:
+        return isSupported(KernelVariant::avx2) && juce::SystemStats::hasAVX512F()
+            && juce::SystemStats::hasAVX512VL() && juce::SystemStats::hasAVX512DQ()
+            && juce::SystemStats::hasAVX512BW() && juce::SystemStats::hasAVX512CD();
+#endif
+    default:
+        return false;
+    }
+}
+
+void CpuDispatch::setForcedVariant(KernelVariant variant) noexcept
+{
+    forcedVariant.store((int)variant, std::memory_order_relaxed);
+}
+
+const char* CpuDispatch::getName(KernelVariant variant) noexcept
+{
+    switch (variant)
+    {
+    case KernelVariant::generic:    return "generic";
+    case KernelVariant::avx2:       return "avx2";
+    case KernelVariant::avx512:     return "avx512";
+    default:                        return "automatic";
+    }
+}
+
+//==============================================================================
+KernelVariant CpuDispatch::getEnvironmentVariant() noexcept
+{
+    static const auto variant = []
+    {
+        const auto name = juce::SystemStats::getEnvironmentVariable("NLFILTER_KERNEL", {}).trim().toLowerCase();
+
+        for (auto candidate : { KernelVariant::generic, KernelVariant::avx2, KernelVariant::avx512 })
+            if (name == getName(candidate))
+                return candidate;
+
+        return KernelVariant::automatic;
+    }();
+
+    return variant;
+}
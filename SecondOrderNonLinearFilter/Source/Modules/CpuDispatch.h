@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    CpuDispatch.h
+    Created: 20 Oct 2026 5:47:19am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef CPUDISPATCH_H_INCLUDED
+#define CPUDISPATCH_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** The vectorising kernels are compiled once for the baseline instruction
+    set and again for AVX2 and AVX-512 on x86 builds. GCC and Clang target
+    single functions, so every instance is built from the kernel's own file.
+    MSVC cannot, so the wider instances are built in CpuDispatchAvx2.cpp and
+    CpuDispatchAvx512.cpp, which the avx2 and avx512 compiler flag schemes
+    compile with /arch:AVX2 and /arch:AVX512. MSVC debug builds keep to the
+    baseline, as nothing is inlined there.
+
+    Set NLFILTER_CPU_DISPATCH=0 in the exporter's preprocessor definitions to
+    build the baseline kernels only; other compilers always do. */
+#ifndef NLFILTER_CPU_DISPATCH
+ #if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG || (JUCE_MSVC && ! JUCE_DEBUG))
+  #define NLFILTER_CPU_DISPATCH 1
+ #else
+  #define NLFILTER_CPU_DISPATCH 0
+ #endif
+#endif
+
+#if NLFILTER_CPU_DISPATCH && ! JUCE_MSVC
+ #define NLFILTER_TARGET_AVX2 __attribute__((target("avx2,fma"), flatten))
+ #define NLFILTER_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx512dq,avx512bw,avx512cd,avx2,fma"), flatten))
+#endif
+
+/** Instruction-set levels the kernels can run at. The generic level is the
+    baseline of the build (SSE2 on x86-64). */
+enum class KernelVariant
+{
+    automatic = 0,
+    generic,
+    avx2,
+    avx512
+};
+
+/** The instances of one kernel, one per variant. A variant the build does
+    not have is null, and runs the generic instance instead.
+*/
+template <typename Function>
+struct KernelTable
+{
+    Function generic = nullptr, avx2 = nullptr, avx512 = nullptr;
+
+    /** Returns the instance to call for a variant. */
+    Function get(KernelVariant variant) const noexcept
+    {
+        if (variant == KernelVariant::avx512 && avx512 != nullptr)
+            return avx512;
+
+        if (variant != KernelVariant::generic && avx2 != nullptr)
+            return avx2;
+
+        return generic;
+    }
+};
+
+//==============================================================================
+/** Picks the kernel variant to run at, from the CPU the plugin finds itself
+    on.
+
+    Only kernels whose inner loop runs across independent lanes are
+    dispatched: FilterBank's voices and MultibandSaturator's bands. Each is a
+    static function template over KernelVariant, whose instances go into a
+    KernelTable built with makeTable(). Processors ask for the variant in
+    prepare() and call the table's instance for it with each block. The
+    variants can differ in the last bits of their results, where fused
+    multiply-adds round once instead of twice.
+
+    The main filter and FilterChain are not dispatched: each runs one
+    recurrence per channel, which a wider instruction set does not speed up.
+
+    A kernel's instances must only call functions that inline into them. On
+    MSVC, anything left out of line in a wide unit could be picked by the
+    linker for the baseline code too.
+
+    For benchmarking, a variant can be forced, either with
+    setForcedVariant() or by setting the NLFILTER_KERNEL environment variable
+    to "generic", "avx2" or "avx512" before the plugin loads. A forced
+    variant the CPU cannot run falls back to the best one it can. The
+    Benchmark console project times each kernel at every variant.
+*/
+class CpuDispatch
+{
+public:
+    //==============================================================================
+    /** Returns the variant processors should run at: the forced one if there
+    is one, otherwise the best the CPU supports. */
+    static KernelVariant getVariant() noexcept;
+
+    /** Returns the best variant the CPU and the build support. */
+    static KernelVariant getBestVariant() noexcept;
+
+    /** Returns true if the CPU and the build can run a variant. */
+    static bool isSupported(KernelVariant variant) noexcept;
+
+    /** Forces a variant for processors prepared from now on. automatic goes
+    back to detecting it. */
+    static void setForcedVariant(KernelVariant variant) noexcept;
+
+    /** Returns the name of a variant, as used by NLFILTER_KERNEL. */
+    static const char* getName(KernelVariant variant) noexcept;
+
+    //==============================================================================
+    /** Builds the table of a kernel from its three instances. On MSVC the
+    wide instances must be declared extern where the table is built, so that
+    only the ones compiled in the wide units exist. */
+    template <auto Generic, auto Avx2, auto Avx512>
+    static constexpr KernelTable<decltype(Generic)> makeTable() noexcept
+    {
+#if NLFILTER_CPU_DISPATCH && JUCE_MSVC
+        return { Generic, Avx2, Avx512 };
+#elif NLFILTER_CPU_DISPATCH
+        return { Generic, &Entry<Avx2>::runAvx2, &Entry<Avx512>::runAvx512 };
+#else
+        return { Generic, nullptr, nullptr };
+#endif
+    }
+
+private:
+    //==============================================================================
+#if NLFILTER_CPU_DISPATCH && ! JUCE_MSVC
+    /** Entry points built for the wider instruction sets, which inline the
+    whole kernel into themselves. */
+    template <auto Kernel>
+    struct Entry;
+
+    template <typename... Args, void (*Kernel)(Args...) noexcept>
+    struct Entry<Kernel>
+    {
+        NLFILTER_TARGET_AVX2 static void runAvx2(Args... args) noexcept { Kernel(args...); }
+        NLFILTER_TARGET_AVX512 static void runAvx512(Args... args) noexcept { Kernel(args...); }
+    };
+#endif
+
+    /** Reads NLFILTER_KERNEL, once. */
+    static KernelVariant getEnvironmentVariant() noexcept;
+
+    static std::atomic<int> forcedVariant;
+};
+
+#endif //CPUDISPATCH_H_INCLUDED
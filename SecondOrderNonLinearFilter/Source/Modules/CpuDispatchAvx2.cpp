@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    CpuDispatchAvx2.cpp
+    Created: 20 Oct 2026 9:41:27am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "CpuDispatch.h"
+
+/*  The avx2 instances of the dispatched kernels, for MSVC. The avx2 compiler
+    flag scheme builds this file with /arch:AVX2. It must hold nothing but the
+    kernel instances, as anything else here would be built for AVX2 too. GCC
+    and Clang build these instances in the kernels' own files. */
+
+#if NLFILTER_CPU_DISPATCH && JUCE_MSVC
+
+ #ifndef __AVX2__
+  #error "CpuDispatchAvx2.cpp must be built with /arch:AVX2, through the avx2 compiler flag scheme."
+ #endif
+
+#include "FilterBank.h"
+#include "MultibandSaturator.h"
+
+NLFILTER_FILTERBANK_KERNELS(, KernelVariant::avx2)
+NLFILTER_MULTIBAND_KERNELS(, KernelVariant::avx2)
+
+#endif
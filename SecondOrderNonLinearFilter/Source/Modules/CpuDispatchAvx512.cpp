@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    CpuDispatchAvx512.cpp
+    Created: 20 Oct 2026 9:41:27am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "CpuDispatch.h"
+
+/*  The avx512 instances of the dispatched kernels, for MSVC. The avx512
+    compiler flag scheme builds this file with /arch:AVX512. It must hold
+    nothing but the kernel instances, as anything else here would be built
+    for AVX-512 too. GCC and Clang build these instances in the kernels' own
+    files. */
+
+#if NLFILTER_CPU_DISPATCH && JUCE_MSVC
+
+ #ifndef __AVX512F__
+  #error "CpuDispatchAvx512.cpp must be built with /arch:AVX512, through the avx512 compiler flag scheme."
+ #endif
+
+#include "FilterBank.h"
+#include "MultibandSaturator.h"
+
+NLFILTER_FILTERBANK_KERNELS(, KernelVariant::avx512)
+NLFILTER_MULTIBAND_KERNELS(, KernelVariant::avx512)
+
+#endif
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    FastMath.cpp
+    Created: 19 Oct 2026 5:12:36pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "FastMath.h"
+
+namespace
+{
+    /*  Minimax polynomials, fitted with the Remez exchange on the reduced
+        ranges below. The errors quoted are of the polynomials themselves. */
+
+    /** sin(x) on [-pi/4, pi/4], as x.(1 + x^2.P(x^2)). Relative error < 3.8e-9. */
+    inline double sinPoly(double x) noexcept
+    {
+        const auto s = x * x;
+
+        return x + x * s * (-1.6666654609548492e-1 + s * (8.332160761853653e-3
+            + s * -1.951528319142458e-4));
+    }
+
+    /** cos(x) on [-pi/4, pi/4], as 1 - x^2.Q(x^2). The relative error of
+        1 - cos(x) is below 6.4e-10, so tiny angles keep their accuracy. */
+    inline double cosPoly(double x) noexcept
+    {
+        const auto s = x * x;
+
+        return 1.0 - s * (4.99999999683871e-1 + s * (-4.1666650432222264e-2
+            + s * (1.3887580007212648e-3 + s * -2.4462801459411313e-5)));
+    }
+
+    /** 2^f on [-1/2, 1/2], as 1 + f.R(f). Relative error < 3.9e-9. */
+    inline double exp2Poly(double f) noexcept
+    {
+        return 1.0 + f * (6.931472253950112e-1 + f * (2.402265108411736e-1
+            + f * (5.5502973141995156e-2 + f * (9.618030782497634e-3
+            + f * (1.3410000966024135e-3 + f * 1.5469731979898962e-4)))));
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void FastMath<SampleType>::sinCos(SampleType x, SampleType& sinOut, SampleType& cosOut) noexcept
+{
+    jassert(std::abs(x) <= static_cast<SampleType>(2.0 * juce::MathConstants<double>::pi));
+
+    // x = n.pi/2 + r with |r| <= pi/4; pi/2 is split in two so that r keeps
+    // its accuracy when it is small.
+    const auto t = static_cast<double>(x);
+    const auto n = juce::roundToInt(t * 0.63661977236758134308);
+    const auto r = (t - n * 1.5707963267341256) - n * 6.077100506506192e-11;
+
+    const auto s = sinPoly(r), c = cosPoly(r);
+
+    // Odd quadrants swap sin and cos; the signs follow the quadrant.
+    const auto quadrant = n & 3;
+    const auto swap = (quadrant & 1) != 0;
+
+    const auto sinT = swap ? c : s;
+    const auto cosT = swap ? s : c;
+
+    sinOut = static_cast<SampleType>((quadrant & 2) != 0 ? -sinT : sinT);
+    cosOut = static_cast<SampleType>(((quadrant + 1) & 2) != 0 ? -cosT : cosT);
+}
+
+template <typename SampleType>
+SampleType FastMath<SampleType>::decibelsToGain(SampleType decibels) noexcept
+{
+    // 10^(dB/20) = 2^(dB.log2(10)/20)
+    return exp2(decibels * static_cast<SampleType>(0.16609640474436811739));
+}
+
+template <typename SampleType>
+SampleType FastMath<SampleType>::exp2(SampleType x) noexcept
+{
+    // 2^x = 2^n . 2^f with n the nearest integer and |f| <= 1/2. 2^n is
+    // written straight into the exponent bits.
+    const auto t = juce::jlimit(-1022.0, 1023.0, static_cast<double>(x));
+    const auto n = juce::roundToInt(t);
+
+    const auto bits = (uint64_t)(n + 1023) << 52;
+    double scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+
+    return static_cast<SampleType>(scale * exp2Poly(t - n));
+}
+
+template struct FastMath<float>;
+template struct FastMath<double>;
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 19 Oct 2026 5:12:36pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef FASTMATH_H_INCLUDED
+#define FASTMATH_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** Polynomial replacements for the library calls used by the coefficient
+    designs, and a rational tanh for the saturators that can trade accuracy
+    for speed.
+
+    Arguments are reduced to a small interval ([-pi/4, pi/4] for the trig,
+    and [-1/2, 1/2] for the exponential) where low-order minimax polynomials
+    are evaluated with Horner's rule, in double precision. Measured against
+    std::sin, std::cos and std::pow over their whole ranges, the maximum
+    errors are:
+
+        sin           3.8e-9 relative (degree 7)
+        cos           2.7e-9 absolute (degree 8), shrinking with x^2 towards
+                      0, so low cutoffs keep their accuracy
+        exp2          3.9e-9 relative (degree 6), and exactly 1 at 0 dB
+
+    for double, and the rounding of float for float. That is far finer than
+    any cutoff or gain can be heard at, at about half the cost of the libm
+    calls. No calls into libm are made.
+*/
+template <typename SampleType>
+struct FastMath
+{
+    /** Computes sin(x) and cos(x) together. Accurate for |x| <= 2.pi. */
+    static void sinCos(SampleType x, SampleType& sinOut, SampleType& cosOut) noexcept;
+
+    /** Returns 10^(decibels / 20). */
+    static SampleType decibelsToGain(SampleType decibels) noexcept;
+
+    /** Returns 2^x. */
+    static SampleType exp2(SampleType x) noexcept;
+
+    /** Clamped [7/6] Pade approximation of tanh, within 1e-4 of it. It has
+    no branches, so loops over it vectorise. */
+    static SampleType tanh(SampleType x) noexcept;
+
+    /** The same approximation, clamped in floating point, for code that
+    runs one value at a time. That clamp is cheaper there, but GCC will not
+    vectorise it. */
+    static SampleType tanhScalar(SampleType x) noexcept;
+
+private:
+    /** The approximant itself, for |x| up to tanhLimit. */
+    static SampleType pade(SampleType x) noexcept;
+
+    /** The approximant reaches 1 here, and is monotonic below it. */
+    static constexpr auto tanhLimit = static_cast<SampleType>(4.971786858527657);
+};
+
+//==============================================================================
+/*  Defined here rather than in FastMath.cpp, as they run per sample in the
+    filters' inner loops. */
+
+template <typename SampleType>
+forcedinline SampleType FastMath<SampleType>::tanh(SampleType x) noexcept
+{
+    // The magnitude is clamped as an integer, which orders like the value for
+    // non-negative floats. Compilers will not turn a floating-point compare
+    // into a vector select while it may raise an exception, but an integer
+    // one they will. A NaN clamps to the limit.
+    using Bits = std::conditional_t<sizeof(SampleType) == 8, int64_t, int32_t>;
+    constexpr auto signBit = std::numeric_limits<Bits>::min();
+
+    Bits bits, limitBits;
+    std::memcpy(&bits, &x, sizeof(x));
+    std::memcpy(&limitBits, &tanhLimit, sizeof(tanhLimit));
+
+    const auto magnitude = bits & ~signBit;
+    bits = (bits & signBit) | (magnitude > limitBits ? limitBits : magnitude);
+    std::memcpy(&x, &bits, sizeof(x));
+
+    return pade(x);
+}
+
+template <typename SampleType>
+forcedinline SampleType FastMath<SampleType>::tanhScalar(SampleType x) noexcept
+{
+    return pade(std::copysign(std::min(std::abs(x), tanhLimit), x));
+}
+
+template <typename SampleType>
+forcedinline SampleType FastMath<SampleType>::pade(SampleType x) noexcept
+{
+    const auto x2 = x * x;
+
+    const auto num = x * (static_cast<SampleType>(135135.0) + x2 * (static_cast<SampleType>(17325.0)
+        + x2 * (static_cast<SampleType>(378.0) + x2)));
+    const auto den = static_cast<SampleType>(135135.0) + x2 * (static_cast<SampleType>(62370.0)
+        + x2 * (static_cast<SampleType>(3150.0) + x2 * static_cast<SampleType>(28.0)));
+
+    return num / den;
+}
+
+#endif //FASTMATH_H_INCLUDED
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    FilterBank.cpp
+    Created: 19 Oct 2026 9:04:51pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "FilterBank.h"
+
+template <typename SampleType, int NumVoices>
+FilterBank<SampleType, NumVoices>::FilterBank()
+{
+    hz.fill(static_cast<SampleType>(1000.0));
+    q.fill(static_cast<SampleType>(0.5));
+    g.fill(static_cast<SampleType>(0.0));
+    active.fill(0);
+    dirty.fill(1);
+
+    b0.fill(static_cast<SampleType>(1.0));
+    b1.fill(static_cast<SampleType>(0.0));
+    b2.fill(static_cast<SampleType>(0.0));
+    a1.fill(static_cast<SampleType>(0.0));
+    a2.fill(static_cast<SampleType>(0.0));
+
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::setFrequency(int voice, SampleType newFreq) noexcept
+{
+    jassert(juce::isPositiveAndBelow(voice, NumVoices));
+    jassert(static_cast<SampleType>(20.0) <= newFreq && newFreq <= static_cast<SampleType>(20000.0));
+
+    hz[(size_t)voice] = newFreq;
+    dirty[(size_t)voice] = 1;
+}
+
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::setResonance(int voice, SampleType newRes) noexcept
+{
+    jassert(juce::isPositiveAndBelow(voice, NumVoices));
+    jassert(static_cast<SampleType>(0.0) <= newRes && newRes <= static_cast<SampleType>(1.0));
+
+    q[(size_t)voice] = newRes;
+    dirty[(size_t)voice] = 1;
+}
+
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::setGain(int voice, SampleType newGain) noexcept
+{
+    jassert(juce::isPositiveAndBelow(voice, NumVoices));
+
+    g[(size_t)voice] = newGain;
+    dirty[(size_t)voice] = 1;
+}
+
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::setFilterType(filterType newFiltType) noexcept
+{
+    if (filtType != newFiltType)
+    {
+        filtType = newFiltType;
+        dirty.fill(1);
+        reset();
+    }
+}
+
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::setSaturationType(satType newTransformType) noexcept
+{
+    if (saturationType != newTransformType)
+    {
+        saturationType = newTransformType;
+        reset();
+    }
+}
+
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::setVoiceActive(int voice, bool shouldBeActive) noexcept
+{
+    jassert(juce::isPositiveAndBelow(voice, NumVoices));
+
+    const auto v = (size_t)voice;
+
+    // A released lane is cleared too, so it idles at exact zero.
+    s1[v] = static_cast<SampleType>(0.0);
+    s2[v] = static_cast<SampleType>(0.0);
+    active[v] = shouldBeActive ? 1 : 0;
+}
+
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::updateCoefficients() noexcept
+{
+    for (size_t v = 0; v < (size_t)NumVoices; ++v)
+    {
+        if (dirty[v] == 0)
+            continue;
+
+        const auto c = SecondOrderNLfilter<SampleType>::design(filtType, hz[v], q[v], g[v], sampleRate);
+
+        b0[v] = c.b0;
+        b1[v] = c.b1;
+        b2[v] = c.b2;
+        a1[v] = c.a1;
+        a2[v] = c.a2;
+        dirty[v] = 0;
+    }
+}
+
+//==============================================================================
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    kernelVariant = CpuDispatch::getVariant();
+
+    dirty.fill(1);
+    updateCoefficients();
+    reset();
+}
+
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::reset() noexcept
+{
+    s1.fill(static_cast<SampleType>(0.0));
+    s2.fill(static_cast<SampleType>(0.0));
+}
+
+//==============================================================================
+template <typename SampleType, int NumVoices>
+void FilterBank<SampleType, NumVoices>::process(SampleType* const* voiceBuffers, int numSamples) noexcept
+{
+    updateCoefficients();
+
+    for (int start = 0; start < numSamples; start += maxFrames)
+    {
+        const auto numFrames = juce::jmin(maxFrames, numSamples - start);
+
+        // Interleave the voices; silent lanes keep the loop below branch-free.
+        for (size_t v = 0; v < (size_t)NumVoices; ++v)
+        {
+            if (active[v] != 0)
+            {
+                const auto* src = voiceBuffers[v] + start;
+
+                for (int i = 0; i < numFrames; ++i)
+                    frames[(size_t)i][v] = src[i];
+            }
+
+            else
+            {
+                for (int i = 0; i < numFrames; ++i)
+                    frames[(size_t)i][v] = static_cast<SampleType>(0.0);
+            }
+        }
+
+        kernels.get(kernelVariant)(*this, numFrames);
+
+        for (size_t v = 0; v < (size_t)NumVoices; ++v)
+        {
+            if (active[v] == 0)
+                continue;
+
+            auto* dst = voiceBuffers[v] + start;
+
+            for (int i = 0; i < numFrames; ++i)
+                dst[i] = frames[(size_t)i][v];
+        }
+    }
+}
+
+//==============================================================================
+#if NLFILTER_CPU_DISPATCH && JUCE_MSVC
+NLFILTER_FILTERBANK_KERNELS(extern, KernelVariant::avx2)
+NLFILTER_FILTERBANK_KERNELS(extern, KernelVariant::avx512)
+#endif
+
+template <typename SampleType, int NumVoices>
+const KernelTable<typename FilterBank<SampleType, NumVoices>::Kernel> FilterBank<SampleType, NumVoices>::kernels
+    = CpuDispatch::makeTable<&frameKernel<KernelVariant::generic>, &frameKernel<KernelVariant::avx2>, &frameKernel<KernelVariant::avx512>>();
+
+template class FilterBank<float, 4>;
+template class FilterBank<float, 8>;
+template class FilterBank<float, 16>;
+template class FilterBank<float, 32>;
+template class FilterBank<double, 4>;
+template class FilterBank<double, 8>;
+template class FilterBank<double, 16>;
+template class FilterBank<double, 32>;
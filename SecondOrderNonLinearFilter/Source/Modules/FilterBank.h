@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    FilterBank.h
+    Created: 19 Oct 2026 9:04:51pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef FILTERBANK_H_INCLUDED
+#define FILTERBANK_H_INCLUDED
+
+#include <JuceHeader.h>
+
+#include "SecondOrderNLfilter.h"
+#include "CpuDispatch.h"
+
+/** A fixed bank of independent second-order nonlinear filters, one per synth
+    voice.
+
+    Each voice has its own frequency, resonance, gain and state; the filter
+    type and saturation position are shared by the whole bank. Coefficients
+    and states are held as structure-of-arrays, one lane per voice, and all
+    lanes are run in lockstep so the inner loop over voices vectorises.
+    Inactive lanes are fed silence rather than skipped, which keeps the loop
+    free of branches.
+
+    Nothing is allocated after construction, so voices can be activated and
+    released from the audio thread.
+
+    The saturators are a clamped Pade approximation of tanh (within 1e-4 of
+    it) without anti-aliasing, and NL3/NL4 always use the explicit feedback
+    form.
+*/
+template <typename SampleType, int NumVoices>
+class FilterBank
+{
+public:
+    using filterType = FilterType;
+    using satType = SaturationType;
+    //==============================================================================
+    /** Constructor. */
+    FilterBank();
+
+    //==============================================================================
+    /** Sets the centre Frequency of one voice. Range = 20..20000 */
+    void setFrequency(int voice, SampleType newFreq) noexcept;
+
+    /** Sets the resonance of one voice. Range = 0..1 */
+    void setResonance(int voice, SampleType newRes) noexcept;
+
+    /** Sets the centre Frequency gain of one voice. Peak and shelf modes only. */
+    void setGain(int voice, SampleType newGain) noexcept;
+
+    /** Sets the type of every filter in the bank. See enum for available types. */
+    void setFilterType(filterType newFiltType) noexcept;
+
+    /** Sets the saturation position of every filter in the bank. See enum for available types. */
+    void setSaturationType(satType newTransformType) noexcept;
+
+    /** Starts or stops a voice. A voice starts from a cleared state. */
+    void setVoiceActive(int voice, bool shouldBeActive) noexcept;
+
+    /** Returns true if the voice is running. */
+    bool isVoiceActive(int voice) const noexcept { return active[(size_t)voice] != 0; }
+
+    /** Redesigns the coefficients of any voice whose settings have changed
+    since the last call. process() calls this once per block. */
+    void updateCoefficients() noexcept;
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Resets the internal state variables of every voice. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes one mono buffer per voice, in place. voiceBuffers must hold
+    NumVoices pointers; those of inactive voices are not touched and may be
+    null. */
+    void process(SampleType* const* voiceBuffers, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    /** Runs every lane over the interleaved frames, at the bank's saturation
+    position. One instance per variant; see CpuDispatch. */
+    template <KernelVariant Variant>
+    static void frameKernel(FilterBank& bank, int numFrames) noexcept;
+
+    /** Runs every lane over the interleaved frames. */
+    template <KernelVariant Variant, SaturationType type>
+    void processFrames(int numFrames) noexcept;
+
+    using Kernel = void (*)(FilterBank&, int) noexcept;
+    static const KernelTable<Kernel> kernels;
+
+    //==============================================================================
+    using Lanes = std::array<SampleType, (size_t)NumVoices>;
+
+    static constexpr int maxFrames = 64;
+
+    /** Coefficients and states, one lane per voice. */
+    Lanes b0, b1, b2, a1, a2, s1, s2;
+
+    /** Per-voice settings. */
+    Lanes hz, q, g;
+    std::array<uint8_t, (size_t)NumVoices> active, dirty;
+
+    /** Voice-interleaved scratch frames, frame-major. */
+    std::array<Lanes, (size_t)maxFrames> frames;
+
+    //==============================================================================
+    /** Shared settings. */
+    filterType filtType = filterType::lowPass2;
+    satType saturationType = satType::linear;
+    KernelVariant kernelVariant = KernelVariant::generic;
+    double sampleRate = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FilterBank)
+};
+
+//==============================================================================
+/*  The kernel is defined here rather than in FilterBank.cpp, so that the
+    instruction-set units can build their own instances of it. It is not
+    inline: an extern template declaration does not keep a compiler from
+    instantiating an inline function, and FilterBank.cpp must not build the
+    wide instances itself. */
+
+template <typename SampleType, int NumVoices>
+template <KernelVariant Variant>
+void FilterBank<SampleType, NumVoices>::frameKernel(FilterBank& bank, int numFrames) noexcept
+{
+    switch (bank.saturationType)
+    {
+    case SaturationType::nonlinear1:
+        bank.processFrames<Variant, SaturationType::nonlinear1>(numFrames);
+        break;
+    case SaturationType::nonlinear2:
+        bank.processFrames<Variant, SaturationType::nonlinear2>(numFrames);
+        break;
+    case SaturationType::nonlinear3:
+        bank.processFrames<Variant, SaturationType::nonlinear3>(numFrames);
+        break;
+    case SaturationType::nonlinear4:
+        bank.processFrames<Variant, SaturationType::nonlinear4>(numFrames);
+        break;
+    case SaturationType::linear:
+    default:
+        bank.processFrames<Variant, SaturationType::linear>(numFrames);
+        break;
+    }
+}
+
+template <typename SampleType, int NumVoices>
+template <KernelVariant Variant, SaturationType type>
+inline void FilterBank<SampleType, NumVoices>::processFrames(int numFrames) noexcept
+{
+    constexpr auto satB0 = (type == SaturationType::nonlinear1 || type == SaturationType::nonlinear4);
+    constexpr auto satB = (type == SaturationType::nonlinear2 || type == SaturationType::nonlinear4);
+    constexpr auto satA = (type == SaturationType::nonlinear3 || type == SaturationType::nonlinear4);
+
+    // Local copies, so the compiler can keep the lanes in registers.
+    const auto B0 = b0, B1 = b1, B2 = b2, A1 = a1, A2 = a2;
+    auto S1 = s1, S2 = s2;
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        auto& frame = frames[(size_t)i];
+
+        for (size_t v = 0; v < (size_t)NumVoices; ++v)
+        {
+            const auto Xn = frame[v];
+
+            auto yb0 = Xn * B0[v];
+            if constexpr (satB0)
+                yb0 = FastMath<SampleType>::tanh(yb0);
+
+            const auto Yn = yb0 + S2[v];
+
+            auto xb1 = Xn * B1[v], xb2 = Xn * B2[v];
+            if constexpr (satB)
+            {
+                xb1 = FastMath<SampleType>::tanh(xb1);
+                xb2 = FastMath<SampleType>::tanh(xb2);
+            }
+
+            auto ya1 = Yn * A1[v], ya2 = Yn * A2[v];
+            if constexpr (satA)
+            {
+                ya1 = FastMath<SampleType>::tanh(ya1);
+                ya2 = FastMath<SampleType>::tanh(ya2);
+            }
+
+            S2[v] = xb1 + S1[v] + ya1;
+            S1[v] = xb2 + ya2;
+            frame[v] = Yn;
+        }
+    }
+
+    s1 = S1;
+    s2 = S2;
+}
+
+/*  The instances of frameKernel() at one variant, for every bank built in
+    FilterBank.cpp. The instruction-set units define them, and FilterBank.cpp
+    declares them extern, with the prefix. */
+#define NLFILTER_FILTERBANK_KERNELS(prefix, variant) \
+    prefix template void FilterBank<float, 4>::frameKernel<variant>(FilterBank<float, 4>&, int) noexcept; \
+    prefix template void FilterBank<float, 8>::frameKernel<variant>(FilterBank<float, 8>&, int) noexcept; \
+    prefix template void FilterBank<float, 16>::frameKernel<variant>(FilterBank<float, 16>&, int) noexcept; \
+    prefix template void FilterBank<float, 32>::frameKernel<variant>(FilterBank<float, 32>&, int) noexcept; \
+    prefix template void FilterBank<double, 4>::frameKernel<variant>(FilterBank<double, 4>&, int) noexcept; \
+    prefix template void FilterBank<double, 8>::frameKernel<variant>(FilterBank<double, 8>&, int) noexcept; \
+    prefix template void FilterBank<double, 16>::frameKernel<variant>(FilterBank<double, 16>&, int) noexcept; \
+    prefix template void FilterBank<double, 32>::frameKernel<variant>(FilterBank<double, 32>&, int) noexcept;
+
+#endif //FILTERBANK_H_INCLUDED
@@ -0,0 +1,528 @@
+/*
+  ==============================================================================
+
+    FilterChain.cpp
+    Created: 20 Oct 2026 4:21:17am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "FilterChain.h"
+
+template <typename SampleType, int MaxBands>
+FilterChain<SampleType, MaxBands>::FilterChain()
+{
+    hz.fill(static_cast<SampleType>(1000.0));
+    q.fill(static_cast<SampleType>(0.5));
+    g.fill(static_cast<SampleType>(0.0));
+    types.fill(filterType::peak);
+    requestedTypes.fill(filterType::peak);
+    saturation.fill(satType::linear);
+    enabled.fill(0);
+    dirty.fill(1);
+    mix.fill(static_cast<SampleType>(0.0));
+    mixStep.fill(static_cast<SampleType>(0.0));
+    switching.fill(0);
+    full.fill(0);
+    satB0.fill(0);
+    satB.fill(0);
+    satA.fill(0);
+
+    b0.fill(static_cast<SampleType>(1.0));
+    b1.fill(static_cast<SampleType>(0.0));
+    b2.fill(static_cast<SampleType>(0.0));
+    a1.fill(static_cast<SampleType>(0.0));
+    a2.fill(static_cast<SampleType>(0.0));
+
+    updateActiveBands();
+}
+
+//==============================================================================
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setFrequency(int band, SampleType newFreq) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+
+    const auto b = (size_t)band;
+    const auto limited = juce::jlimit(minFreq, maxFreq, newFreq);
+
+    if (hz[b] != limited)
+    {
+        hz[b] = limited;
+        dirty[b] = 1;
+        fullBands[b].setFrequency(limited);
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setResonance(int band, SampleType newRes) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+    jassert(static_cast<SampleType>(0.0) <= newRes && newRes <= static_cast<SampleType>(1.0));
+
+    const auto b = (size_t)band;
+
+    if (q[b] != newRes)
+    {
+        q[b] = newRes;
+        dirty[b] = 1;
+        fullBands[b].setResonance(newRes);
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setGain(int band, SampleType newGain) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+
+    const auto b = (size_t)band;
+
+    if (g[b] != newGain)
+    {
+        g[b] = newGain;
+        dirty[b] = 1;
+        fullBands[b].setGain(newGain);
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setFilterType(int band, filterType newFiltType) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+
+    const auto b = (size_t)band;
+
+    // The old type's state means nothing to the new one, so the band fades
+    // out on the old type and back in on the new one.
+    if (requestedTypes[b] != newFiltType)
+    {
+        requestedTypes[b] = newFiltType;
+        requestSwitch(b);
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setSaturationType(int band, satType newTransformType) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+
+    const auto b = (size_t)band;
+
+    if (saturation[b] != newTransformType)
+    {
+        saturation[b] = newTransformType;
+
+        // The fast path's saturators switch without touching its state; a
+        // full filter resets itself, so it changes behind a fade.
+        if (full[b] == 0 && ! needsFullFilter(b))
+        {
+            satB0[b] = (newTransformType == satType::nonlinear1 || newTransformType == satType::nonlinear4) ? 1 : 0;
+            satB[b] = (newTransformType == satType::nonlinear2 || newTransformType == satType::nonlinear4) ? 1 : 0;
+            satA[b] = (newTransformType == satType::nonlinear3 || newTransformType == satType::nonlinear4) ? 1 : 0;
+
+            fullBands[b].setSaturationType(newTransformType);
+            updateActiveBands();
+        }
+
+        else
+        {
+            requestSwitch(b);
+        }
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setBandEnabled(int band, bool shouldBeEnabled) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+
+    const auto b = (size_t)band;
+
+    if ((enabled[b] != 0) == shouldBeEnabled)
+        return;
+
+    enabled[b] = shouldBeEnabled ? 1 : 0;
+
+    // A band part way through a switch fades back in, or not, once it is done.
+    if (switching[b] != 0)
+        return;
+
+    // A band coming back from silence starts from rest.
+    if (shouldBeEnabled && mix[b] == static_cast<SampleType>(0.0))
+        clearBand(b);
+
+    mixStep[b] = shouldBeEnabled ? fadeStep : -fadeStep;
+
+    updateActiveBands();
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setAntiAliasing(aaType newAntiAliasing) noexcept
+{
+    if (antiAliasing != newAntiAliasing)
+    {
+        antiAliasing = newAntiAliasing;
+
+        for (auto& f : fullBands)
+            f.setAntiAliasing(antiAliasing);
+
+        updatePaths();
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setZeroDelayFeedback(bool shouldUseZdf) noexcept
+{
+    if (zdf != shouldUseZdf)
+    {
+        zdf = shouldUseZdf;
+
+        // The filters reset themselves; only the bands that move are heard to.
+        for (auto& f : fullBands)
+            f.setZeroDelayFeedback(zdf);
+
+        updatePaths();
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setEngine(engineType newEngine) noexcept
+{
+    if (engine != newEngine)
+    {
+        engine = newEngine;
+
+        for (auto& f : fullBands)
+            f.setEngine(engine);
+
+        updatePaths();
+    }
+}
+
+//==============================================================================
+template <typename SampleType, int MaxBands>
+bool FilterChain<SampleType, MaxBands>::needsFullFilter(size_t band) const noexcept
+{
+    const auto type = saturation[band];
+    const auto saturatesFeedback = type == satType::nonlinear3 || type == satType::nonlinear4;
+
+    return engine == engineType::stateVariable
+        || (type != satType::linear && (antiAliasing != aaType::none || (zdf && saturatesFeedback)));
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::requestSwitch(size_t band) noexcept
+{
+    if (mix[band] == static_cast<SampleType>(0.0) && mixStep[band] <= static_cast<SampleType>(0.0))
+    {
+        applySwitch(band);
+        return;
+    }
+
+    switching[band] = 1;
+    mixStep[band] = -fadeStep;
+
+    updateActiveBands();
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::applySwitch(size_t band) noexcept
+{
+    const auto type = saturation[band];
+
+    types[band] = requestedTypes[band];
+    dirty[band] = 1;
+
+    full[band] = needsFullFilter(band) ? 1 : 0;
+    satB0[band] = (type == satType::nonlinear1 || type == satType::nonlinear4) ? 1 : 0;
+    satB[band] = (type == satType::nonlinear2 || type == satType::nonlinear4) ? 1 : 0;
+    satA[band] = (type == satType::nonlinear3 || type == satType::nonlinear4) ? 1 : 0;
+
+    fullBands[band].setFilterType(types[band]);
+    fullBands[band].setSaturationType(type);
+
+    clearBand(band);
+
+    switching[band] = 0;
+    mixStep[band] = (enabled[band] != 0) ? fadeStep : static_cast<SampleType>(0.0);
+
+    updateActiveBands();
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::updatePaths() noexcept
+{
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+        if ((full[b] != 0) != needsFullFilter(b))
+            requestSwitch(b);
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::clearBand(size_t band) noexcept
+{
+    for (auto& states : s1)
+        states[band] = static_cast<SampleType>(0.0);
+
+    for (auto& states : s2)
+        states[band] = static_cast<SampleType>(0.0);
+
+    fullBands[band].reset();
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::advanceFades(size_t numSamples) noexcept
+{
+    const SampleType zero = (0.0), one = (1.0);
+
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+    {
+        if (mixStep[b] == zero)
+            continue;
+
+        mix[b] = juce::jlimit(zero, one, mix[b] + mixStep[b] * static_cast<SampleType>(numSamples));
+
+        if (mix[b] == one && mixStep[b] > zero)
+        {
+            mixStep[b] = zero;
+        }
+
+        else if (mix[b] == zero && mixStep[b] < zero)
+        {
+            mixStep[b] = zero;
+
+            // Out of the chain, or ready for its change.
+            if (switching[b] != 0)
+                applySwitch(b);
+            else
+                clearBand(b);
+        }
+    }
+
+    updateActiveBands();
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::processFullBand(size_t band, juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+    const auto isFading = mixStep[band] != static_cast<SampleType>(0.0);
+
+    auto dryBlock = juce::dsp::AudioBlock<SampleType>(dryBuffer)
+        .getSubsetChannelBlock(0, numChannels)
+        .getSubBlock(0, numSamples);
+
+    if (isFading)
+        dryBlock.copyFrom(block);
+
+    juce::dsp::ProcessContextReplacing<SampleType> context(block);
+    fullBands[band].process(context);
+
+    if (! isFading)
+        return;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* dry = dryBlock.getChannelPointer(channel);
+        auto* wet = block.getChannelPointer(channel);
+        auto m = mix[band];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            m = juce::jlimit(SampleType(0.0), SampleType(1.0), m + mixStep[band]);
+            wet[i] = dry[i] + m * (wet[i] - dry[i]);
+        }
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::updateActiveBands() noexcept
+{
+    numActive = 0;
+    anyNonlinear = false;
+    anyFading = false;
+
+    // Bands that are fading out still run until they are silent.
+    for (int band = 0; band < MaxBands; ++band)
+    {
+        const auto b = (size_t)band;
+
+        if (mix[b] == static_cast<SampleType>(0.0) && mixStep[b] <= static_cast<SampleType>(0.0))
+            continue;
+
+        active[(size_t)numActive++] = band;
+        anyNonlinear = anyNonlinear || (full[b] == 0 && saturation[b] != satType::linear);
+        anyFading = anyFading || mixStep[b] != static_cast<SampleType>(0.0);
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::updateCoefficients() noexcept
+{
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+    {
+        if (dirty[b] == 0)
+            continue;
+
+        const auto c = SecondOrderNLfilter<SampleType>::design(types[b], hz[b], q[b], g[b], sampleRate);
+
+        b0[b] = c.b0;
+        b1[b] = c.b1;
+        b2[b] = c.b2;
+        a1[b] = c.a1;
+        a2[b] = c.a2;
+        dirty[b] = 0;
+    }
+}
+
+template <typename SampleType, int MaxBands>
+SampleType FilterChain<SampleType, MaxBands>::getDecaySamples(SampleType level, SampleType maxSamples) const noexcept
+{
+    auto total = static_cast<SampleType>(0.0);
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        const auto band = (size_t)active[(size_t)i];
+        const auto c = BiquadCoefficients<SampleType>{ b0[band], b1[band], b2[band], a1[band], a2[band] };
+
+        total += (full[band] != 0) ? fullBands[band].getDecaySamples(level, maxSamples)
+                                   : SecondOrderNLfilter<SampleType>::getDecaySamples(c, level, maxSamples);
+    }
+
+    return juce::jmin(total, maxSamples);
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::setOversamplingFactor(int newFactor) noexcept
+{
+    jassert(newFactor > 0);
+
+    oversamplingFactor = juce::jmax(1, newFactor);
+    fadeStep = static_cast<SampleType>(1.0 / (fadeSeconds * sampleRate * oversamplingFactor));
+
+    // Fades already running carry on in the same direction at the new rate.
+    for (auto& step : mixStep)
+        if (step != static_cast<SampleType>(0.0))
+            step = step > static_cast<SampleType>(0.0) ? fadeStep : -fadeStep;
+}
+
+//==============================================================================
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+
+    s1.resize(spec.numChannels);
+    s2.resize(spec.numChannels);
+
+    // Sized for the highest oversampling factor, as the chain runs on the
+    // oversampled block.
+    dryBuffer.setSize((int)spec.numChannels, (int)spec.maximumBlockSize << 4);
+
+    for (auto& f : fullBands)
+        f.prepare(spec);
+
+    fadeStep = static_cast<SampleType>(1.0 / (fadeSeconds * sampleRate * oversamplingFactor));
+
+    minFreq = static_cast <SampleType> (sampleRate / 24576.0);
+    maxFreq = static_cast <SampleType> (sampleRate / 2.125);
+
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+    {
+        auto& f = fullBands[b];
+
+        hz[b] = juce::jlimit(minFreq, maxFreq, hz[b]);
+        f.setFrequency(hz[b]);
+        f.setResonance(q[b]);
+        f.setGain(g[b]);
+        f.setFilterType(types[b]);
+        f.setSaturationType(saturation[b]);
+        f.setAntiAliasing(antiAliasing);
+        f.setZeroDelayFeedback(zdf);
+        f.setEngine(engine);
+        f.updateCoefficients();
+    }
+
+    dirty.fill(1);
+    updateCoefficients();
+    reset();
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::reset() noexcept
+{
+    for (auto v : { &s1, &s2 })
+        for (auto& states : *v)
+            states.fill(static_cast<SampleType>(0.0));
+
+    for (auto& f : fullBands)
+        f.reset();
+
+    // Fades in progress are finished at once.
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+    {
+        if (switching[b] != 0)
+            applySwitch(b);
+
+        mix[b] = (enabled[b] != 0) ? static_cast<SampleType>(1.0) : static_cast<SampleType>(0.0);
+        mixStep[b] = static_cast<SampleType>(0.0);
+    }
+
+    updateActiveBands();
+}
+
+template <typename SampleType, int MaxBands>
+void FilterChain<SampleType, MaxBands>::copyStateFrom(const FilterChain& other) noexcept
+{
+    jassert(s1.size() == other.s1.size());
+
+    b0 = other.b0;
+    b1 = other.b1;
+    b2 = other.b2;
+    a1 = other.a1;
+    a2 = other.a2;
+
+    std::copy(other.s1.begin(), other.s1.end(), s1.begin());
+    std::copy(other.s2.begin(), other.s2.end(), s2.begin());
+
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+        fullBands[b].copyStateFrom(other.fullBands[b]);
+
+    hz = other.hz;
+    q = other.q;
+    g = other.g;
+    types = other.types;
+    requestedTypes = other.requestedTypes;
+    saturation = other.saturation;
+    enabled = other.enabled;
+    dirty = other.dirty;
+    mix = other.mix;
+    mixStep = other.mixStep;
+    switching = other.switching;
+    full = other.full;
+    satB0 = other.satB0;
+    satB = other.satB;
+    satA = other.satA;
+
+    active = other.active;
+    numActive = other.numActive;
+    anyNonlinear = other.anyNonlinear;
+    anyFading = other.anyFading;
+
+    antiAliasing = other.antiAliasing;
+    engine = other.engine;
+    zdf = other.zdf;
+
+    minFreq = other.minFreq;
+    maxFreq = other.maxFreq;
+    fadeStep = other.fadeStep;
+    sampleRate = other.sampleRate;
+    oversamplingFactor = other.oversamplingFactor;
+}
+
+template class FilterChain<float, 8>;
+template class FilterChain<double, 8>;
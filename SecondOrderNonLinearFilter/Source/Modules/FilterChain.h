@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    FilterChain.h
+    Created: 20 Oct 2026 4:21:17am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef FILTERCHAIN_H_INCLUDED
+#define FILTERCHAIN_H_INCLUDED
+
+#include <JuceHeader.h>
+
+#include "SecondOrderNLfilter.h"
+
+/** A chain of up to MaxBands second-order nonlinear filters in series, as
+    the bands of a parametric equaliser.
+
+    Every band has its own frequency, resonance, gain, type and saturation
+    position. Coefficients, settings and states are held as
+    structure-of-arrays, one lane per band. Each block gathers the enabled
+    bands into local arrays, in band order, and runs them all in a single loop
+    per sample, so the signal passes through the whole chain while it is in
+    registers. Each band feeds the next, so that loop cannot vectorise across
+    the bands, and it is left at the baseline instruction set. Disabled bands
+    are left out of the loop entirely, and a chain with no band enabled
+    returns without touching the audio.
+
+    The designs are those of SecondOrderNLfilter, and in that loop the
+    saturators are the scalar rational tanh of FastMath. The global
+    anti-aliasing, zero-delay feedback and engine settings are still
+    honoured: a band that they would change (any band on the state-variable
+    engine, and a saturating band with anti-aliasing on, or with zero-delay
+    feedback and saturated feedback paths) runs through a full
+    SecondOrderNLfilter of its own instead, in its place in the chain.
+
+    Switching a band in or out, changing its type, or moving it between the
+    two paths never jumps: the band's output is crossfaded with its input,
+    fading out before the change and back in after it from a cleared state.
+
+    Nothing is allocated after prepare(), so bands can be switched and retuned
+    from the audio thread.
+*/
+template <typename SampleType, int MaxBands>
+class FilterChain
+{
+public:
+    using filterType = FilterType;
+    using satType = SaturationType;
+    using aaType = AntiAliasingType;
+    using engineType = FilterEngine;
+    //==============================================================================
+    /** Constructor. */
+    FilterChain();
+
+    //==============================================================================
+    /** Sets the centre Frequency of one band. Range = 20..20000 */
+    void setFrequency(int band, SampleType newFreq) noexcept;
+
+    /** Sets the resonance of one band. Range = 0..1 */
+    void setResonance(int band, SampleType newRes) noexcept;
+
+    /** Sets the centre Frequency gain of one band. Peak and shelf modes only. */
+    void setGain(int band, SampleType newGain) noexcept;
+
+    /** Sets the type of one band. See enum for available types. */
+    void setFilterType(int band, filterType newFiltType) noexcept;
+
+    /** Sets the saturation position of one band. See enum for available types. */
+    void setSaturationType(int band, satType newTransformType) noexcept;
+
+    /** Switches a band in or out of the chain, with a crossfade. A band
+    starts from a cleared state. */
+    void setBandEnabled(int band, bool shouldBeEnabled) noexcept;
+
+    /** Returns true if the band is in the chain. */
+    bool isBandEnabled(int band) const noexcept { return enabled[(size_t)band] != 0; }
+
+    /** Sets the anti-aliasing order of every band's saturators. */
+    void setAntiAliasing(aaType newAntiAliasing) noexcept;
+
+    /** Switches zero-delay feedback on or off for every band. */
+    void setZeroDelayFeedback(bool shouldUseZdf) noexcept;
+
+    /** Sets the engine every band runs on. */
+    void setEngine(engineType newEngine) noexcept;
+
+    /** Sets the factor the chain's block is oversampled by, so that band
+    crossfades last the same time at any factor. The frequencies are still
+    given already divided by it. */
+    void setOversamplingFactor(int newFactor) noexcept;
+
+    /** Redesigns the coefficients of any band whose settings have changed
+    since the last call. process() calls this once per block. */
+    void updateCoefficients() noexcept;
+
+    //==============================================================================
+    /** Returns the number of samples the impulse response of the enabled
+    bands takes to decay below the given level, as the sum of their own. */
+    SampleType getDecaySamples(SampleType level, SampleType maxSamples) const noexcept;
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Resets the internal state variables of every band. */
+    void reset() noexcept;
+
+    /** Copies the settings, coefficients and state of another chain that was
+    prepared with the same spec. */
+    void copyStateFrom(const FilterChain& other) noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert(inputBlock.getNumChannels() == numChannels);
+        jassert(inputBlock.getNumSamples() == numSamples);
+        jassert(numChannels <= s1.size());
+
+        updateCoefficients();
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom(inputBlock);
+
+        if (context.isBypassed || numActive == 0)
+            return;
+
+        // Runs of bands on the fast path share one loop; the others take
+        // their turn in between, in band order.
+        for (size_t first = 0; first < (size_t)numActive;)
+        {
+            if (full[(size_t)active[first]] != 0)
+            {
+                processFullBand((size_t)active[first], outputBlock);
+                ++first;
+                continue;
+            }
+
+            auto last = first + 1;
+
+            while (last < (size_t)numActive && full[(size_t)active[last]] == 0)
+                ++last;
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* samples = outputBlock.getChannelPointer(channel);
+
+                if (anyNonlinear && anyFading)
+                    processChannel<true, true>(channel, samples, numSamples, first, last);
+                else if (anyNonlinear)
+                    processChannel<true, false>(channel, samples, numSamples, first, last);
+                else if (anyFading)
+                    processChannel<false, true>(channel, samples, numSamples, first, last);
+                else
+                    processChannel<false, false>(channel, samples, numSamples, first, last);
+            }
+
+            first = last;
+        }
+
+        if (anyFading)
+            advanceFades(numSamples);
+    }
+
+private:
+    //==============================================================================
+    /** Lists the bands that are in the chain or fading, in order, and notes
+    whether any on the fast path saturates and whether any is fading. */
+    void updateActiveBands() noexcept;
+
+    /** Returns true if the global settings change how a band sounds, so it
+    needs a full filter rather than the fast path. */
+    bool needsFullFilter(size_t band) const noexcept;
+
+    /** Fades a band out, so that its type or path can change, unless it is
+    already silent, in which case the change is made straight away. */
+    void requestSwitch(size_t band) noexcept;
+
+    /** Makes a pending change to a silent band, and fades it back in if it
+    is enabled. */
+    void applySwitch(size_t band) noexcept;
+
+    /** Moves any band that no longer suits its path over to the other one. */
+    void updatePaths() noexcept;
+
+    /** Clears a band's states on both paths. */
+    void clearBand(size_t band) noexcept;
+
+    /** Moves the fades on past a block, and finishes those that are done. */
+    void advanceFades(size_t numSamples) noexcept;
+
+    /** Runs one band on its full filter, in place. */
+    void processFullBand(size_t band, juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+    /** Runs the bands active[first] to active[last - 1] over one channel, in
+    place. */
+    template <bool nonlinear, bool fading>
+    void processChannel(size_t channel, SampleType* samples, size_t numSamples, size_t first, size_t last) noexcept;
+
+    //==============================================================================
+    using Lanes = std::array<SampleType, (size_t)MaxBands>;
+    using Flags = std::array<uint8_t, (size_t)MaxBands>;
+
+    /** Coefficients, one lane per band. */
+    Lanes b0, b1, b2, a1, a2;
+
+    /** States, one set of lanes per channel. */
+    std::vector<Lanes> s1, s2;
+
+    /** Per-band settings. The type in use only follows the requested one
+    once the band has faded out. */
+    Lanes hz, q, g;
+    std::array<filterType, (size_t)MaxBands> types, requestedTypes;
+    std::array<satType, (size_t)MaxBands> saturation;
+    Flags enabled, dirty;
+
+    /** How much of each band's output is mixed in, and how far that moves
+    per sample. A band waiting to change fades to zero first. */
+    Lanes mix, mixStep;
+    Flags switching;
+
+    /** Bands on the full filters, and the filters themselves. */
+    Flags full;
+    std::array<SecondOrderNLfilter<SampleType>, (size_t)MaxBands> fullBands;
+    juce::AudioBuffer<SampleType> dryBuffer;
+
+    /** Saturation positions of each band: on the b0 path, the other
+    feed-forward paths and the feedback paths. */
+    Flags satB0, satB, satA;
+
+    /** The enabled bands, in order. */
+    std::array<int, (size_t)MaxBands> active;
+    int numActive = 0;
+    bool anyNonlinear = false, anyFading = false;
+
+    //==============================================================================
+    aaType antiAliasing = aaType::none;
+    engineType engine = engineType::directForm;
+    bool zdf = false;
+
+    //==============================================================================
+    SampleType minFreq = 20.0, maxFreq = 20000.0, fadeStep = 0.001;
+    static constexpr double fadeSeconds = 0.02;
+    const SampleType snapLevel = (1.0e-8);
+    double sampleRate = 48000.0;
+    int oversamplingFactor = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FilterChain)
+};
+
+//==============================================================================
+/*  The per-sample kernel is defined here rather than in FilterChain.cpp, so it
+    inlines into process(). */
+
+template <typename SampleType, int MaxBands>
+template <bool nonlinear, bool fading>
+inline void FilterChain<SampleType, MaxBands>::processChannel(size_t channel, SampleType* samples, size_t numSamples, size_t first, size_t last) noexcept
+{
+    // The bands are gathered into local copies, so the compiler can keep them
+    // in registers across the sample loop.
+    Lanes B0, B1, B2, A1, A2, S1, S2, M, D;
+    Flags SB0, SB, SA;
+
+    auto& states1 = s1[channel];
+    auto& states2 = s2[channel];
+    const auto n = last - first;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto band = (size_t)active[first + i];
+
+        B0[i] = b0[band];
+        B1[i] = b1[band];
+        B2[i] = b2[band];
+        A1[i] = a1[band];
+        A2[i] = a2[band];
+        S1[i] = states1[band];
+        S2[i] = states2[band];
+        SB0[i] = satB0[band];
+        SB[i] = satB[band];
+        SA[i] = satA[band];
+
+        // Every channel replays the fades from the start of the block.
+        M[i] = mix[band];
+        D[i] = mixStep[band];
+    }
+
+    for (size_t sample = 0; sample < numSamples; ++sample)
+    {
+        auto Xn = samples[sample];
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto yb0 = Xn * B0[i];
+            auto xb1 = Xn * B1[i], xb2 = Xn * B2[i];
+
+            if constexpr (nonlinear)
+            {
+                if (SB0[i] != 0)
+                    yb0 = FastMath<SampleType>::tanhScalar(yb0);
+
+                if (SB[i] != 0)
+                {
+                    xb1 = FastMath<SampleType>::tanhScalar(xb1);
+                    xb2 = FastMath<SampleType>::tanhScalar(xb2);
+                }
+            }
+
+            const auto Yn = yb0 + S2[i];
+
+            auto ya1 = Yn * A1[i], ya2 = Yn * A2[i];
+
+            if constexpr (nonlinear)
+            {
+                if (SA[i] != 0)
+                {
+                    ya1 = FastMath<SampleType>::tanhScalar(ya1);
+                    ya2 = FastMath<SampleType>::tanhScalar(ya2);
+                }
+            }
+
+            S2[i] = xb1 + S1[i] + ya1;
+            S1[i] = xb2 + ya2;
+
+            if constexpr (fading)
+            {
+                M[i] = juce::jlimit(SampleType(0.0), SampleType(1.0), M[i] + D[i]);
+                Xn += M[i] * (Yn - Xn);
+            }
+
+            else
+            {
+                Xn = Yn;
+            }
+        }
+
+        samples[sample] = Xn;
+    }
+
+    // Tiny states are rounded to zero on the way back, so a decaying chain
+    // never idles in the denormal range.
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto band = (size_t)active[first + i];
+
+        states1[band] = (std::abs(S1[i]) < snapLevel) ? SampleType(0.0) : S1[i];
+        states2[band] = (std::abs(S2[i]) < snapLevel) ? SampleType(0.0) : S2[i];
+    }
+}
+
+#endif //FILTERCHAIN_H_INCLUDED
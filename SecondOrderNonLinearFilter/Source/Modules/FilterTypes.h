@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    FilterTypes.h
+    Created: 20 Oct 2026 3:05:41am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef FILTERTYPES_H_INCLUDED
+#define FILTERTYPES_H_INCLUDED
+
+/** Settings shared by the filter engines. */
+
+enum struct FilterType
+{
+    lowPass2 = 0,
+    lowPass1 = 1,
+    highPass2 = 2,
+    highPass1 = 3,
+    bandPass = 4,
+    bandPassQ = 5,
+    lowShelf2 = 6,
+    lowShelf1 = 7,
+    lowShelf1C = 8,
+    highShelf2 = 9,
+    highShelf1 = 10,
+    highShelf1C = 11,
+    peak = 12,
+    notch = 13,
+    allPass = 14
+};
+
+enum class SaturationType
+{
+    linear = 0,
+    nonlinear1 = 1,
+    nonlinear2 = 2,
+    nonlinear3 = 3,
+    nonlinear4 = 4
+};
+
+enum class DenormalStrategy
+{
+    ftzDaz = 0,
+    snapToZero = 1,
+    offset = 2
+};
+
+#endif //FILTERTYPES_H_INCLUDED
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    LatencyDelay.cpp
+    Created: 20 Oct 2026 7:12:05am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "LatencyDelay.h"
+
+template <typename SampleType>
+void LatencyDelay<SampleType>::prepare(const juce::dsp::ProcessSpec& spec, int newMaxDelaySamples)
+{
+    jassert(newMaxDelaySamples >= 0);
+
+    maxDelaySamples = delaySamples = juce::jmax(0, newMaxDelaySamples);
+
+    // One slot more than the longest delay, so the sample written is never
+    // the one about to be read unless the delay is zero.
+    buffer.setSize((int)spec.numChannels, maxDelaySamples + 1);
+    reset();
+}
+
+template <typename SampleType>
+void LatencyDelay<SampleType>::reset() noexcept
+{
+    buffer.clear();
+    position = 0;
+}
+
+template <typename SampleType>
+void LatencyDelay<SampleType>::setDelaySamples(int newDelaySamples) noexcept
+{
+    jassert(juce::isPositiveAndNotGreaterThan(newDelaySamples, maxDelaySamples));
+
+    delaySamples = juce::jlimit(0, maxDelaySamples, newDelaySamples);
+}
+
+//==============================================================================
+template <typename SampleType>
+void LatencyDelay<SampleType>::process(juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    if (maxDelaySamples == 0)
+        return;
+
+    jassert(block.getNumChannels() <= (size_t)buffer.getNumChannels());
+
+    const auto numSamples = block.getNumSamples();
+    const auto length = maxDelaySamples + 1;
+    auto next = position;
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* samples = block.getChannelPointer(channel);
+        auto* line = buffer.getWritePointer((int)channel);
+        next = position;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            line[next] = samples[i];
+
+            const auto read = next - delaySamples;
+            samples[i] = line[read < 0 ? read + length : read];
+
+            next = (next + 1 == length) ? 0 : next + 1;
+        }
+    }
+
+    position = next;
+}
+
+template class LatencyDelay<float>;
+template class LatencyDelay<double>;
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    LatencyDelay.h
+    Created: 20 Oct 2026 7:12:05am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef LATENCYDELAY_H_INCLUDED
+#define LATENCYDELAY_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** Delays every channel of a block by a whole number of samples, so that
+    paths with different latencies line up with one another.
+
+    The longest delay is fixed in prepare(); nothing is allocated after it.
+    The line keeps recording at any length, so a longer delay picks up from
+    the samples already passed through it rather than from silence.
+*/
+template <typename SampleType>
+class LatencyDelay
+{
+public:
+    //==============================================================================
+    /** Initialises the delay with the given length, in samples, which is
+    also the longest it can be set to afterwards. */
+    void prepare(const juce::dsp::ProcessSpec& spec, int newMaxDelaySamples);
+
+    /** Clears the delayed samples. */
+    void reset() noexcept;
+
+    /** Sets the length of the delay, up to the length it was prepared with. */
+    void setDelaySamples(int newDelaySamples) noexcept;
+
+    /** Returns the length of the delay, in samples. */
+    int getDelaySamples() const noexcept { return delaySamples; }
+
+    //==============================================================================
+    /** Delays the block in place. */
+    void process(juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+private:
+    //==============================================================================
+    juce::AudioBuffer<SampleType> buffer;
+    int delaySamples = 0, maxDelaySamples = 0, position = 0;
+};
+
+#endif //LATENCYDELAY_H_INCLUDED
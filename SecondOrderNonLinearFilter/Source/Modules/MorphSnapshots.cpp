@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    MorphSnapshots.cpp
+    Created: 20 Oct 2026 2:26:19am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "MorphSnapshots.h"
+
+const char* const MorphSnapshots::parameterIDs[numSettings] = { "frequencyID", "resonanceID", "gainID", "driveID",
+                                                                "outputID", "mixID", "typeID", "linearityID" };
+
+MorphSnapshots::MorphSnapshots()
+{
+    for (auto& snapshot : snapshots)
+        snapshot.fill(0.0f);
+
+    stored.fill(false);
+}
+
+//==============================================================================
+void MorphSnapshots::store(int slot, juce::AudioProcessorValueTreeState& state)
+{
+    jassert(juce::isPositiveAndBelow(slot, (int)numSlots));
+
+    Snapshot snapshot;
+
+    for (size_t i = 0; i < (size_t)numSettings; ++i)
+        snapshot[i] = state.getRawParameterValue(parameterIDs[i])->load();
+
+    const juce::SpinLock::ScopedLockType scopedLock(lock);
+    snapshots[(size_t)slot] = snapshot;
+    stored[(size_t)slot] = true;
+    version.fetch_add(1, std::memory_order_release);
+}
+
+void MorphSnapshots::clear()
+{
+    const juce::SpinLock::ScopedLockType scopedLock(lock);
+    stored.fill(false);
+    version.fetch_add(1, std::memory_order_release);
+}
+
+bool MorphSnapshots::isStored(int slot) const noexcept
+{
+    const juce::SpinLock::ScopedLockType scopedLock(lock);
+    return stored[(size_t)slot];
+}
+
+//==============================================================================
+bool MorphSnapshots::pull(Snapshot& a, Snapshot& b, bool& engaged, uint32_t& lastVersion) noexcept
+{
+    if (version.load(std::memory_order_acquire) == lastVersion)
+        return false;
+
+    const juce::SpinLock::ScopedTryLockType scopedLock(lock);
+
+    if (! scopedLock.isLocked())
+        return false;
+
+    a = snapshots[slotA];
+    b = snapshots[slotB];
+    engaged = stored[slotA] && stored[slotB];
+    lastVersion = version.load(std::memory_order_relaxed);
+
+    return true;
+}
+
+//==============================================================================
+void MorphSnapshots::writeTo(juce::MemoryBlock& destData) const
+{
+    destData.setSize(0);
+    juce::MemoryOutputStream stream(destData, false);
+
+    const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+    stream.writeShort((short)numSettings);
+    stream.writeShort((short)((stored[slotA] ? 1 : 0) | (stored[slotB] ? 2 : 0)));
+
+    for (auto& snapshot : snapshots)
+        for (auto value : snapshot)
+            stream.writeFloat(value);
+
+    stream.flush();
+}
+
+void MorphSnapshots::readFrom(const void* data, size_t sizeInBytes)
+{
+    const auto expectedSize = (size_t)(4 + numSlots * numSettings * 4);
+
+    juce::MemoryInputStream stream(data, sizeInBytes, false);
+
+    const auto isValid = data != nullptr && sizeInBytes == expectedSize && stream.readShort() == numSettings;
+    const auto mask = isValid ? (int)stream.readShort() : 0;
+
+    std::array<Snapshot, (size_t)numSlots> restored;
+
+    for (auto& snapshot : restored)
+        for (auto& value : snapshot)
+            value = isValid ? stream.readFloat() : 0.0f;
+
+    const juce::SpinLock::ScopedLockType scopedLock(lock);
+    snapshots = restored;
+    stored[slotA] = (mask & 1) != 0;
+    stored[slotB] = (mask & 2) != 0;
+    version.fetch_add(1, std::memory_order_release);
+}
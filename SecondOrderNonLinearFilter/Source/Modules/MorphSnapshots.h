@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    MorphSnapshots.h
+    Created: 20 Oct 2026 2:26:19am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef MORPHSNAPSHOTS_H_INCLUDED
+#define MORPHSNAPSHOTS_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** Two stored sets of filter settings, A and B, for the morph control to
+    move between.
+
+    Snapshots are taken on the message thread from the current parameter
+    values and handed to the audio thread under a spin lock that the audio
+    thread only ever tries, so it never waits: if a snapshot is being stored
+    at that moment, the audio thread picks it up on the next block instead.
+*/
+class MorphSnapshots
+{
+public:
+    enum Slot
+    {
+        slotA = 0,
+        slotB,
+        numSlots
+    };
+
+    /** The settings held in a snapshot. */
+    enum Setting
+    {
+        frequency = 0,
+        resonance,
+        gain,
+        drive,
+        output,
+        mix,
+        type,
+        linearity,
+        numSettings
+    };
+
+    /** Plain (not normalised) parameter values, indexed by Setting. */
+    using Snapshot = std::array<float, (size_t)numSettings>;
+
+    //==========================================================================
+    /** Constructor. */
+    MorphSnapshots();
+
+    //==========================================================================
+    /** Stores the current values of the parameters in a slot. */
+    void store(int slot, juce::AudioProcessorValueTreeState& state);
+
+    /** Discards both snapshots, which hands the settings back to their own
+    parameters. */
+    void clear();
+
+    /** Returns true if the slot holds a snapshot. */
+    bool isStored(int slot) const noexcept;
+
+    //==========================================================================
+    /** Copies out both snapshots if they have changed since lastVersion, and
+    updates it. engaged is true when both slots are stored. Returns false if
+    nothing changed, or if a store is in progress. Audio thread only. */
+    bool pull(Snapshot& a, Snapshot& b, bool& engaged, uint32_t& lastVersion) noexcept;
+
+    //==========================================================================
+    /** Serialises the snapshots, for the plugin state. */
+    void writeTo(juce::MemoryBlock& destData) const;
+
+    /** Restores snapshots written by writeTo(). Anything else clears them. */
+    void readFrom(const void* data, size_t sizeInBytes);
+
+private:
+    //==========================================================================
+    /** The parameter behind each setting. */
+    static const char* const parameterIDs[numSettings];
+
+    juce::SpinLock lock;
+    std::array<Snapshot, (size_t)numSlots> snapshots;
+    std::array<bool, (size_t)numSlots> stored;
+    std::atomic<uint32_t> version{ 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MorphSnapshots)
+};
+
+#endif //MORPHSNAPSHOTS_H_INCLUDED
@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+    MultibandSaturator.cpp
+    Created: 20 Oct 2026 5:02:44am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "MultibandSaturator.h"
+
+template <typename SampleType, int MaxBands>
+MultibandSaturator<SampleType, MaxBands>::MultibandSaturator()
+{
+    // Spread evenly in octaves between 100 Hz and 8 kHz.
+    for (size_t i = 0; i < crossovers.size(); ++i)
+        crossovers[i] = static_cast<SampleType>(100.0 * std::pow(80.0, (double)(i + 1) / (double)MaxBands));
+
+    drive.fill(static_cast<SampleType>(0.0));
+    saturation.fill(satType::linear);
+}
+
+//==============================================================================
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::setNumBands(int newNumBands) noexcept
+{
+    const auto limited = juce::jlimit(1, MaxBands, newNumBands);
+
+    if (numBands != limited)
+    {
+        numBands = limited;
+        dirty = true;
+        reset();
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::setCrossover(int band, SampleType newFreq) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands - 1));
+
+    if (crossovers[(size_t)band] != newFreq)
+    {
+        crossovers[(size_t)band] = newFreq;
+        dirty = true;
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::setDrive(int band, SampleType newDrive) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+
+    if (drive[(size_t)band] != newDrive)
+    {
+        drive[(size_t)band] = newDrive;
+        dirty = true;
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::setSaturationType(int band, satType newTransformType) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, MaxBands));
+
+    const auto b = (size_t)band;
+
+    if (saturation[b] != newTransformType)
+    {
+        // The driven bands start again from rest; the linear signal runs on.
+        saturation[b] = newTransformType;
+        clear(bank);
+        dirty = true;
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::clear(Bank& target) noexcept
+{
+    for (auto v : { &target.s1, &target.s2 })
+        for (auto& states : *v)
+            for (auto& stage : states)
+                stage.fill(static_cast<SampleType>(0.0));
+}
+
+//==============================================================================
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::updateCoefficients() noexcept
+{
+    if (! dirty)
+        return;
+
+    dirty = false;
+
+    const SampleType zero = (0.0), one = (1.0);
+
+    std::array<bool, (size_t)MaxBands> isDriven;
+    int numDriven = 0, newLayout = 0;
+
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+    {
+        isDriven[b] = b < (size_t)numBands && saturation[b] != satType::linear;
+        numDriven += isDriven[b] ? 1 : 0;
+        newLayout |= isDriven[b] ? (1 << b) : 0;
+    }
+
+    // The linear bank always holds every band.
+    linearBank.isDriven = false;
+
+    for (size_t b = 0; b < (size_t)MaxBands; ++b)
+        designLane(linearBank, b, b, false, b < (size_t)numBands ? one : zero);
+
+    // Each driven band keeps its own lane of the oversampled bank, and its
+    // twin takes the next lane left free, weighted negative. Without lanes
+    // enough for the twins, every band is oversampled.
+    isMixedRate = numDriven <= MaxBands - numDriven;
+    newLayout |= isMixedRate ? 0 : (1 << MaxBands);
+
+    bank.isDriven = false;
+
+    size_t twin = 0;
+
+    for (size_t lane = 0; lane < (size_t)MaxBands; ++lane)
+    {
+        if (isDriven[lane] || ! isMixedRate)
+        {
+            designLane(bank, lane, lane, isDriven[lane], lane < (size_t)numBands ? one : zero);
+            continue;
+        }
+
+        while (twin < (size_t)MaxBands && ! isDriven[twin])
+            ++twin;
+
+        if (twin < (size_t)MaxBands)
+            designLane(bank, lane, twin++, false, -one);
+        else
+            designLane(bank, lane, lane, false, zero);
+    }
+
+    if (layout != newLayout)
+    {
+        layout = newLayout;
+        clear(bank);
+    }
+}
+
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::designLane(Bank& target, size_t lane, size_t b, bool isDriven, SampleType weight) noexcept
+{
+    const SampleType zero = (0.0), one = (1.0);
+    const auto identity = BiquadCoefficients<SampleType>{ one, zero, zero, zero, zero };
+
+    // The crossovers are taken in order of frequency, whatever their order
+    // in the settings.
+    auto frequencies = crossovers;
+    const auto numCrossovers = (size_t)(numBands - 1);
+    std::sort(frequencies.begin(), frequencies.begin() + (long)numCrossovers);
+
+    const auto maxFreq = static_cast<SampleType>(sampleRate / 2.125);
+
+    auto section = [&](FilterType type, SampleType hz)
+    {
+        return SecondOrderNLfilter<SampleType>::design(type, juce::jlimit(static_cast<SampleType>(20.0), maxFreq, hz), butterworth, zero, target.sampleRate);
+    };
+
+    const auto isInBank = weight != zero;
+
+    std::array<BiquadCoefficients<SampleType>, (size_t)maxStages> chain;
+    chain.fill(identity);
+    size_t stage = 0;
+
+    if (isInBank)
+    {
+        for (size_t i = 0; i < b; ++i)
+        {
+            chain[stage++] = section(FilterType::highPass2, frequencies[i]);
+            chain[stage++] = section(FilterType::highPass2, frequencies[i]);
+        }
+
+        if (b < numCrossovers)
+        {
+            chain[stage++] = section(FilterType::lowPass2, frequencies[b]);
+            chain[stage++] = section(FilterType::lowPass2, frequencies[b]);
+        }
+
+        for (size_t i = b + 1; i < numCrossovers; ++i)
+            chain[stage++] = section(FilterType::allPass, frequencies[i]);
+    }
+
+    const auto masks = std::array<bool, 3>{
+        saturation[b] == satType::nonlinear1 || saturation[b] == satType::nonlinear4,
+        saturation[b] == satType::nonlinear2 || saturation[b] == satType::nonlinear4,
+        saturation[b] == satType::nonlinear3 || saturation[b] == satType::nonlinear4 };
+
+    for (size_t i = 0; i < (size_t)maxStages; ++i)
+    {
+        target.b0[i][lane] = chain[i].b0;
+        target.b1[i][lane] = chain[i].b1;
+        target.b2[i][lane] = chain[i].b2;
+        target.a1[i][lane] = chain[i].a1;
+        target.a2[i][lane] = chain[i].a2;
+
+        // Identity sections pass the band through without saturating it.
+        const auto isSection = isDriven && i < stage;
+        target.satB0[i][lane] = (isSection && masks[0]) ? one : zero;
+        target.satB[i][lane] = (isSection && masks[1]) ? one : zero;
+        target.satA[i][lane] = (isSection && masks[2]) ? one : zero;
+    }
+
+    const auto gain = isDriven ? FastMath<SampleType>::decibelsToGain(drive[b]) : one;
+
+    target.inputGain[lane] = gain;
+    target.outputGain[lane] = weight / gain;
+    target.isDriven = target.isDriven || isDriven;
+}
+
+//==============================================================================
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    kernelVariant = CpuDispatch::getVariant();
+
+    oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>
+        (spec.numChannels, oversamplingOrder, juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple, true, true);
+    oversampler->initProcessing(spec.maximumBlockSize);
+
+    latencySamples = juce::roundToInt(oversampler->getLatencyInSamples());
+    linearDelay.prepare(spec, latencySamples);
+    linearBuffer.setSize((int)spec.numChannels, (int)spec.maximumBlockSize);
+
+    bank.sampleRate = sampleRate * (1 << oversamplingOrder);
+    linearBank.sampleRate = sampleRate;
+
+    for (auto* target : { &bank, &linearBank })
+    {
+        target->s1.resize(spec.numChannels);
+        target->s2.resize(spec.numChannels);
+    }
+
+    dirty = true;
+    updateCoefficients();
+    reset();
+}
+
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::reset() noexcept
+{
+    clear(bank);
+    clear(linearBank);
+
+    if (oversampler != nullptr)
+        oversampler->reset();
+
+    linearDelay.reset();
+    isOversampling = false;
+}
+
+//==============================================================================
+template <typename SampleType, int MaxBands>
+void MultibandSaturator<SampleType, MaxBands>::process(juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    if (numBands < 2)
+        return;
+
+    updateCoefficients();
+
+    const auto& kernel = kernels.get(kernelVariant);
+
+    // With nothing driven, every band runs at the base rate, in place, and
+    // only waits out the latency the split always has.
+    if (! bank.isDriven)
+    {
+        isOversampling = false;
+        kernel(*this, linearBank, block);
+        linearDelay.process(block);
+        return;
+    }
+
+    // The oversampling starts again from silence each time a band is driven
+    // after none were.
+    if (! isOversampling)
+    {
+        oversampler->reset();
+        isOversampling = true;
+    }
+
+    auto linearBlock = juce::dsp::AudioBlock<SampleType>(linearBuffer)
+        .getSubsetChannelBlock(0, block.getNumChannels())
+        .getSubBlock(0, block.getNumSamples());
+
+    // The linear bank runs even while it is not heard, so the linear signal
+    // carries on when it is again.
+    linearBlock.copyFrom(block);
+    kernel(*this, linearBank, linearBlock);
+    linearDelay.process(linearBlock);
+
+    // The driven bands and their twins share one oversampled copy of the
+    // input, and their sum is brought back down in one pass.
+    auto osBlock = oversampler->processSamplesUp(block);
+
+    kernel(*this, bank, osBlock);
+
+    oversampler->processSamplesDown(block);
+
+    if (isMixedRate)
+        block.add(linearBlock);
+}
+
+//==============================================================================
+#if NLFILTER_CPU_DISPATCH && JUCE_MSVC
+NLFILTER_MULTIBAND_KERNELS(extern, KernelVariant::avx2)
+NLFILTER_MULTIBAND_KERNELS(extern, KernelVariant::avx512)
+#endif
+
+template <typename SampleType, int MaxBands>
+const KernelTable<typename MultibandSaturator<SampleType, MaxBands>::Kernel> MultibandSaturator<SampleType, MaxBands>::kernels
+    = CpuDispatch::makeTable<&bankKernel<KernelVariant::generic>, &bankKernel<KernelVariant::avx2>, &bankKernel<KernelVariant::avx512>>();
+
+template class MultibandSaturator<float, 4>;
+template class MultibandSaturator<double, 4>;
@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+    MultibandSaturator.h
+    Created: 20 Oct 2026 5:02:44am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef MULTIBANDSATURATOR_H_INCLUDED
+#define MULTIBANDSATURATOR_H_INCLUDED
+
+#include <JuceHeader.h>
+
+#include "SecondOrderNLfilter.h"
+#include "CpuDispatch.h"
+#include "LatencyDelay.h"
+
+/** Splits the signal into up to MaxBands bands with fourth-order
+    Linkwitz-Riley crossovers, saturates each band on its own, and sums them.
+
+    Each crossover is a pair of Butterworth lowPass2 or highPass2 sections
+    from SecondOrderNLfilter::design(). Every band is its own chain of
+    sections: the high-passes of the crossovers below it, the low-pass of the
+    one above it, and the all-pass of each crossover further up, so that the
+    bands sum to an all-pass. The chains are held as structure-of-arrays, one
+    lane per band, and run in lockstep so the inner loop over bands
+    vectorises. Unused sections are identities.
+
+    A band with a saturation position other than linear runs its sections
+    with saturation at that position, between its drive and the inverse of
+    it, as the main filter does. Only those bands are oversampled. Every
+    band runs linear in one bank at the base rate, delayed by the latency of
+    the oversampling, and since that bank alone sums to an all-pass, it
+    carries the whole of the linear signal. A second bank runs on a 4x
+    oversampled copy of the input, where each driven band has a lane of its
+    own and a linear twin of it in a lane no driven band uses; the twin is
+    taken away from the band, so that only the saturation the band adds
+    comes back down, and the sum stays flat whatever the crossovers. With no
+    band driven the oversampling does not run at all.
+
+    When more bands are driven than leave lanes free for their twins, every
+    band is oversampled in the second bank instead, as one split. That bank
+    starts again from rest whenever its layout changes.
+
+    A single band passes the input straight through, with no latency; from
+    two bands up the latency is that of the oversampling, whatever the
+    saturation settings.
+
+    Nothing is allocated after prepare().
+*/
+template <typename SampleType, int MaxBands>
+class MultibandSaturator
+{
+public:
+    using satType = SaturationType;
+    //==============================================================================
+    /** Constructor. */
+    MultibandSaturator();
+
+    //==============================================================================
+    /** Sets the number of bands. A single band leaves the signal untouched. */
+    void setNumBands(int newNumBands) noexcept;
+
+    /** Sets the frequency of the crossover above the given band. Range = 20..20000 */
+    void setCrossover(int band, SampleType newFreq) noexcept;
+
+    /** Sets the drive into one band, in decibels. */
+    void setDrive(int band, SampleType newDrive) noexcept;
+
+    /** Sets the saturation position of one band. See enum for available types. */
+    void setSaturationType(int band, satType newTransformType) noexcept;
+
+    /** Returns the number of bands. */
+    int getNumBands() const noexcept { return numBands; }
+
+    /** Returns the latency of the split, in samples: zero with a single band,
+    and otherwise set in prepare(). */
+    int getLatencySamples() const noexcept { return numBands < 2 ? 0 : latencySamples; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the block in place. */
+    void process(juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int maxStages = 2 * (MaxBands - 1);
+    static constexpr int oversamplingOrder = 2;
+
+    using Lanes = std::array<SampleType, (size_t)MaxBands>;
+    using Stages = std::array<Lanes, (size_t)maxStages>;
+
+    /** The band chains. */
+    struct Bank
+    {
+        /** Coefficients and saturation masks, per section and band. */
+        Stages b0, b1, b2, a1, a2;
+        Stages satB0, satB, satA;
+
+        /** Drive into each band, and its inverse (or zero, for an unused
+        band) out of it. */
+        Lanes inputGain, outputGain;
+
+        /** States, one set per channel. */
+        std::vector<Stages> s1, s2;
+
+        double sampleRate = 48000.0;
+        bool isDriven = false;
+    };
+
+    //==============================================================================
+    /** Redesigns both banks after a change of settings. */
+    void updateCoefficients() noexcept;
+
+    /** Designs one lane of a bank as the chain of a band, saturating it if
+    isDriven is true, and weights it into the sum. A zero weight leaves the
+    lane unused. */
+    void designLane(Bank& target, size_t lane, size_t band, bool isDriven, SampleType weight) noexcept;
+
+    /** Clears the states of a bank. */
+    static void clear(Bank& target) noexcept;
+
+    /** Runs a bank over every channel of a block at its rate, in place.
+    One instance per variant; see CpuDispatch. */
+    template <KernelVariant Variant>
+    static void bankKernel(MultibandSaturator& split, Bank& target, juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+    /** Runs the lanes of a bank over one channel, writing their sum. */
+    template <KernelVariant Variant, bool nonlinear>
+    void processBank(Bank& target, size_t channel, const SampleType* input, SampleType* output, size_t numSamples) noexcept;
+
+    using Kernel = void (*)(MultibandSaturator&, Bank&, juce::dsp::AudioBlock<SampleType>&) noexcept;
+    static const KernelTable<Kernel> kernels;
+
+    //==============================================================================
+    /** The oversampled bands, and every band linear at the base rate, on
+    its own copy of the input. */
+    Bank bank, linearBank;
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler;
+    juce::AudioBuffer<SampleType> linearBuffer;
+    LatencyDelay<SampleType> linearDelay;
+    int latencySamples = 0;
+    bool isOversampling = false;
+
+    /** True while the linear bank is added to the oversampled one, and a
+    mask of the driven bands and of that, the oversampled bank's layout. */
+    bool isMixedRate = true;
+    int layout = 0;
+
+    //==============================================================================
+    /** Initialised parameter */
+    std::array<SampleType, (size_t)MaxBands - 1> crossovers;
+    Lanes drive;
+    std::array<satType, (size_t)MaxBands> saturation;
+    int numBands = 1;
+    bool dirty = true;
+    KernelVariant kernelVariant = KernelVariant::generic;
+
+    //==============================================================================
+    /** Initialise constants. */
+    const SampleType butterworth = static_cast<SampleType>(1.0 - juce::MathConstants<double>::sqrt2 * 0.5);
+    const SampleType snapLevel = (1.0e-8);
+    double sampleRate = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultibandSaturator)
+};
+
+//==============================================================================
+/*  The kernel is defined here rather than in MultibandSaturator.cpp, so that
+    the instruction-set units can build their own instances of it. Like
+    FilterBank's, it is not inline, so the extern declarations hold. */
+
+template <typename SampleType, int MaxBands>
+template <KernelVariant Variant>
+void MultibandSaturator<SampleType, MaxBands>::bankKernel(MultibandSaturator& split, Bank& target, juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* samples = block.getChannelPointer(channel);
+
+        if (target.isDriven)
+            split.processBank<Variant, true>(target, channel, samples, samples, block.getNumSamples());
+        else
+            split.processBank<Variant, false>(target, channel, samples, samples, block.getNumSamples());
+    }
+}
+
+template <typename SampleType, int MaxBands>
+template <KernelVariant Variant, bool nonlinear>
+inline void MultibandSaturator<SampleType, MaxBands>::processBank(Bank& target, size_t channel, const SampleType* input, SampleType* output, size_t numSamples) noexcept
+{
+    // Local copies, so the compiler can keep the lanes in registers.
+    auto S1 = target.s1[channel];
+    auto S2 = target.s2[channel];
+    const auto numStages = (size_t)(2 * (numBands - 1));
+
+    for (size_t sample = 0; sample < numSamples; ++sample)
+    {
+        Lanes v;
+
+        for (size_t b = 0; b < (size_t)MaxBands; ++b)
+            v[b] = input[sample] * target.inputGain[b];
+
+        for (size_t stage = 0; stage < numStages; ++stage)
+        {
+            for (size_t b = 0; b < (size_t)MaxBands; ++b)
+            {
+                auto yb0 = v[b] * target.b0[stage][b];
+                auto xb1 = v[b] * target.b1[stage][b], xb2 = v[b] * target.b2[stage][b];
+
+                // The masks pick each lane's saturation without a branch.
+                if constexpr (nonlinear)
+                {
+                    yb0 += target.satB0[stage][b] * (FastMath<SampleType>::tanh(yb0) - yb0);
+                    xb1 += target.satB[stage][b] * (FastMath<SampleType>::tanh(xb1) - xb1);
+                    xb2 += target.satB[stage][b] * (FastMath<SampleType>::tanh(xb2) - xb2);
+                }
+
+                const auto Yn = yb0 + S2[stage][b];
+
+                auto ya1 = Yn * target.a1[stage][b], ya2 = Yn * target.a2[stage][b];
+
+                if constexpr (nonlinear)
+                {
+                    ya1 += target.satA[stage][b] * (FastMath<SampleType>::tanh(ya1) - ya1);
+                    ya2 += target.satA[stage][b] * (FastMath<SampleType>::tanh(ya2) - ya2);
+                }
+
+                S2[stage][b] = xb1 + S1[stage][b] + ya1;
+                S1[stage][b] = xb2 + ya2;
+                v[b] = Yn;
+            }
+        }
+
+        auto sum = static_cast<SampleType>(0.0);
+
+        for (size_t b = 0; b < (size_t)MaxBands; ++b)
+            sum += v[b] * target.outputGain[b];
+
+        output[sample] = sum;
+    }
+
+    // Tiny states are rounded to zero on the way back, so a decaying split
+    // never idles in the denormal range.
+    for (size_t stage = 0; stage < numStages; ++stage)
+    {
+        for (size_t b = 0; b < (size_t)MaxBands; ++b)
+        {
+            target.s1[channel][stage][b] = (std::abs(S1[stage][b]) < snapLevel) ? SampleType(0.0) : S1[stage][b];
+            target.s2[channel][stage][b] = (std::abs(S2[stage][b]) < snapLevel) ? SampleType(0.0) : S2[stage][b];
+        }
+    }
+}
+
+/*  The instances of bankKernel() at one variant, for every split built in
+    MultibandSaturator.cpp. The instruction-set units define them, and
+    MultibandSaturator.cpp declares them extern, with the prefix. */
+#define NLFILTER_MULTIBAND_KERNELS(prefix, variant) \
+    prefix template void MultibandSaturator<float, 4>::bankKernel<variant>(MultibandSaturator<float, 4>&, MultibandSaturator<float, 4>::Bank&, juce::dsp::AudioBlock<float>&) noexcept; \
+    prefix template void MultibandSaturator<double, 4>::bankKernel<variant>(MultibandSaturator<double, 4>&, MultibandSaturator<double, 4>::Bank&, juce::dsp::AudioBlock<double>&) noexcept;
+
+#endif //MULTIBANDSATURATOR_H_INCLUDED
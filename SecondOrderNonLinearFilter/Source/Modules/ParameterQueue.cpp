@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    ParameterQueue.cpp
+    Created: 19 Oct 2026 2:41:07pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "ParameterQueue.h"
+
+ParameterQueue::ParameterQueue()
+{
+    for (uint32_t i = 0; i < capacity; ++i)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void ParameterQueue::push(float newValue) noexcept
+{
+    latest.store(newValue, std::memory_order_relaxed);
+
+    auto position = writePosition.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto& slot = slots[position & (capacity - 1)];
+        const auto distance = (int32_t)(slot.sequence.load(std::memory_order_acquire) - position);
+
+        if (distance == 0)
+        {
+            // Claim the slot; on failure, position holds the new write position.
+            if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.event = { newValue };
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return;
+            }
+        }
+
+        else if (distance < 0)
+        {
+            // The slot still holds an unread event from a lap ago: full.
+            overflowed.store(true);
+            return;
+        }
+
+        else
+        {
+            // Another producer claimed this slot first.
+            position = writePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void ParameterQueue::clear(float newValue) noexcept
+{
+    Event event;
+
+    while (peek(event))
+        pop();
+
+    latest.store(newValue, std::memory_order_relaxed);
+    overflowed.store(false);
+}
+
+//==============================================================================
+bool ParameterQueue::peek(Event& event) const noexcept
+{
+    const auto& slot = slots[readPosition & (capacity - 1)];
+
+    if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+        return false;
+
+    event = slot.event;
+    return true;
+}
+
+void ParameterQueue::pop() noexcept
+{
+    // Hand the slot back to the producers for their next lap.
+    slots[readPosition & (capacity - 1)].sequence.store(readPosition + capacity, std::memory_order_release);
+    ++readPosition;
+}
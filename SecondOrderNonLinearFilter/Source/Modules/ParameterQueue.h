@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    ParameterQueue.h
+    Created: 19 Oct 2026 2:41:07pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PARAMETERQUEUE_H_INCLUDED
+#define PARAMETERQUEUE_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** A fixed-size queue of value changes for a single parameter.
+
+    Any number of threads may push at once, and one thread reads. Neither
+    side takes a lock: each slot carries a sequence number that says whether
+    it is free to write or ready to read, and producers claim slots with a
+    compare-and-swap on the write position. A producer that is descheduled
+    part-way through a push only holds back its own event and the ones queued
+    behind it; the reader sees the queue as empty up to that point rather
+    than waiting for it. If the queue fills up, further events are dropped,
+    but the latest value is always kept so the consumer can catch up once it
+    drains the queue.
+*/
+class ParameterQueue
+{
+public:
+    struct Event
+    {
+        float value = 0.0f;
+    };
+
+    //==========================================================================
+    /** Constructor. */
+    ParameterQueue();
+
+    //==========================================================================
+    /** Pushes a new value. Safe to call from any thread. */
+    void push(float newValue) noexcept;
+
+    /** Discards any pending events and sets the latest value. Call this only
+    from the consumer's side. */
+    void clear(float newValue) noexcept;
+
+    //==========================================================================
+    /** Looks at the next pending event without removing it. Consumer only. */
+    bool peek(Event& event) const noexcept;
+
+    /** Removes the next pending event. Consumer only. */
+    void pop() noexcept;
+
+    /** Returns true, and clears the flag, if any events have been dropped. */
+    bool checkAndClearOverflow() noexcept { return overflowed.exchange(false); }
+
+    /** Returns the most recently pushed value. */
+    float getLatest() const noexcept { return latest.load(std::memory_order_relaxed); }
+
+private:
+    //==========================================================================
+    static constexpr uint32_t capacity = 64;
+    static_assert((capacity & (capacity - 1)) == 0, "The capacity must be a power of two.");
+
+    /** A slot is free to write when its sequence equals the write position,
+    and ready to read when it is one past the read position. */
+    struct Slot
+    {
+        std::atomic<uint32_t> sequence{ 0 };
+        Event event;
+    };
+
+    std::array<Slot, (size_t)capacity> slots;
+    std::atomic<uint32_t> writePosition{ 0 };
+    uint32_t readPosition = 0;
+
+    std::atomic<float> latest{ 0.0f };
+    std::atomic<bool> overflowed{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterQueue)
+};
+
+#endif //PARAMETERQUEUE_H_INCLUDED
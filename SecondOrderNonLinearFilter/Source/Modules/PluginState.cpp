@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    PluginState.cpp
+    Created: 20 Oct 2026 12:31:44am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+
+//==============================================================================
+void PluginState::write(const juce::AudioProcessor& processor, juce::MemoryBlock& destData,
+                        const juce::MemoryBlock& extension)
+{
+    const auto& parameters = processor.getParameters();
+
+    destData.setSize(0);
+    juce::MemoryOutputStream stream(destData, false);
+
+    stream.writeInt((int)magic);
+    stream.writeShort((short)currentVersion);
+    stream.writeShort((short)parameters.size());
+
+    for (auto* parameter : parameters)
+    {
+        const auto* ranged = dynamic_cast<const juce::RangedAudioParameter*>(parameter);
+
+        stream.writeInt(ranged != nullptr ? (int)hashID(ranged->paramID) : 0);
+        stream.writeFloat(parameter->getValue());
+    }
+
+    stream.writeInt((int)extension.getSize());
+    stream.write(extension.getData(), extension.getSize());
+
+    stream.flush();
+}
+
+bool PluginState::read(juce::AudioProcessor& processor, const void* data, int sizeInBytes,
+                       juce::MemoryBlock* extension)
+{
+    if (data == nullptr || sizeInBytes < headerSize)
+        return false;
+
+    juce::MemoryInputStream stream(data, (size_t)sizeInBytes, false);
+
+    if ((juce::uint32)stream.readInt() != magic)
+        return false;
+
+    const auto version = (int)(juce::uint16)stream.readShort();
+    const auto numEntries = (int)(juce::uint16)stream.readShort();
+
+    if (version < 1 || version > currentVersion || sizeInBytes < headerSize + numEntries * entrySize)
+        return false;
+
+    const auto& parameters = processor.getParameters();
+
+    std::vector<std::pair<juce::uint32, juce::AudioProcessorParameter*>> byHash;
+    byHash.reserve((size_t)parameters.size());
+
+    for (auto* parameter : parameters)
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            byHash.emplace_back(hashID(ranged->paramID), parameter);
+
+    for (int i = 0; i < numEntries; ++i)
+    {
+        const auto hash = (juce::uint32)stream.readInt();
+        const auto value = stream.readFloat();
+
+        if (! std::isfinite(value))
+            continue;
+
+        for (auto& entry : byHash)
+        {
+            if (entry.first == hash)
+            {
+                // Notifying keeps the host, the value tree and the processing
+                // listeners in step, exactly as a change from the host would.
+                if (entry.second->getValue() != value)
+                    entry.second->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, value));
+
+                break;
+            }
+        }
+    }
+
+    if (extension != nullptr)
+    {
+        extension->setSize(0);
+
+        if (version >= 2 && stream.getNumBytesRemaining() >= 4)
+        {
+            const auto extensionSize = (juce::int64)(juce::uint32)stream.readInt();
+
+            if (extensionSize <= stream.getNumBytesRemaining())
+            {
+                extension->setSize((size_t)extensionSize);
+                stream.read(extension->getData(), (int)extensionSize);
+            }
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+juce::uint32 PluginState::hashID(const juce::String& paramID) noexcept
+{
+    auto hash = (juce::uint32)2166136261u;
+
+    for (auto* c = paramID.toRawUTF8(); *c != 0; ++c)
+    {
+        hash ^= (juce::uint8)*c;
+        hash *= (juce::uint32)16777619u;
+    }
+
+    return hash;
+}
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+    Created: 20 Oct 2026 12:31:44am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PLUGINSTATE_H_INCLUDED
+#define PLUGINSTATE_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** A compact binary form of the plugin state.
+
+    Layout, all little-endian:
+
+        uint32  magic ('NLFS')
+        uint16  format version
+        uint16  number of parameters, n
+        n x { uint32 FNV-1a hash of the parameter ID, float normalised value }
+        uint32  size of the extension, m (version 2 on)
+        m bytes of state that is not held in parameters
+
+    Parameters are matched by the hash of their ID, so the layout can gain or
+    lose parameters between versions; unknown entries are skipped and missing
+    ones keep their current value. Restoring sets each parameter directly,
+    without building or parsing a ValueTree.
+*/
+class PluginState
+{
+public:
+    //==========================================================================
+    /** Writes every parameter of the processor, followed by the extension. */
+    static void write(const juce::AudioProcessor& processor, juce::MemoryBlock& destData,
+                      const juce::MemoryBlock& extension = {});
+
+    /** Restores the parameters of the processor from data written by write(),
+    and copies the extension into extension if it is not null (leaving it
+    empty for states written before there was one). Returns false, without
+    touching anything, if data is not in this format. */
+    static bool read(juce::AudioProcessor& processor, const void* data, int sizeInBytes,
+                     juce::MemoryBlock* extension = nullptr);
+
+    /** Returns the FNV-1a hash of a parameter ID, by which parameters are
+    matched when restoring. */
+    static juce::uint32 hashID(const juce::String& paramID) noexcept;
+
+private:
+    //==========================================================================
+    static constexpr juce::uint32 magic = 0x53464c4e;
+    static constexpr int currentVersion = 2;
+    static constexpr int headerSize = 8, entrySize = 8;
+};
+
+#endif //PLUGINSTATE_H_INCLUDED
@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.cpp
+    Created: 20 Oct 2026 1:12:08am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "PresetLibrary.h"
+
+PresetLibrary::PresetLibrary()
+    :
+    file(getDefaultFile())
+{
+    open();
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    current.store(&empty);
+}
+
+juce::File PresetLibrary::getDefaultFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("StoneyDSP")
+        .getChildFile("SecondOrderNonLinearFilter")
+        .getChildFile("Presets.nlpresets");
+}
+
+//==============================================================================
+PresetLibrary::Targets PresetLibrary::makeTargets(juce::AudioProcessor& processor)
+{
+    Targets targets;
+
+    for (auto* parameter : processor.getParameters())
+    {
+        if (parameter == processor.getBypassParameter())
+            continue;
+
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            targets.push_back({ PluginState::hashID(ranged->paramID), parameter });
+    }
+
+    return targets;
+}
+
+//==============================================================================
+juce::uint32 PresetLibrary::View::getColumn(int column) const noexcept
+{
+    return juce::ByteOrder::littleEndianInt(columns + column * 4);
+}
+
+float PresetLibrary::View::getValue(int index, int column) const noexcept
+{
+    const auto bits = juce::ByteOrder::littleEndianInt(getRecord(index) + nameSize + column * 4);
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int PresetLibrary::getNumPresets() const noexcept
+{
+    const ReadScope scope(*this);
+    return scope.getView().numPresets;
+}
+
+juce::String PresetLibrary::getName(int index) const
+{
+    const ReadScope scope(*this);
+    const auto* view = &scope.getView();
+
+    if (! juce::isPositiveAndBelow(index, view->numPresets))
+        return {};
+
+    const auto* name = view->getRecord(index);
+    size_t length = 0;
+
+    while (length < (size_t)nameSize && name[length] != 0)
+        ++length;
+
+    return juce::String::fromUTF8(name, (int)length);
+}
+
+bool PresetLibrary::apply(int index, const Targets& targets) const noexcept
+{
+    const ReadScope scope(*this);
+    const auto* view = &scope.getView();
+
+    if (! juce::isPositiveAndBelow(index, view->numPresets))
+        return false;
+
+    for (int column = 0; column < view->numColumns; ++column)
+    {
+        const auto value = view->getValue(index, column);
+
+        if (! std::isfinite(value))
+            continue;
+
+        const auto hash = view->getColumn(column);
+
+        for (auto& target : targets)
+        {
+            if (target.hash == hash)
+            {
+                if (target.parameter->getValue() != value)
+                    target.parameter->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, value));
+
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+int PresetLibrary::add(const juce::String& name, const Targets& targets)
+{
+    const juce::CriticalSection::ScopedLockType lock(writeLock);
+
+    // Only this thread publishes, so the view can't be freed under it.
+    const auto* view = current.load();
+
+    // Columns already in the library are kept, so presets saved by other
+    // versions lose nothing; new parameters are added after them.
+    std::vector<juce::uint32> columns;
+
+    for (int column = 0; column < view->numColumns; ++column)
+        columns.push_back(view->getColumn(column));
+
+    for (auto& target : targets)
+        if (std::find(columns.begin(), columns.end(), target.hash) == columns.end())
+            columns.push_back(target.hash);
+
+    const auto numColumns = (int)columns.size();
+    const auto numPresets = view->numPresets + 1;
+
+    if (numColumns > 0xffff || ! file.getParentDirectory().createDirectory())
+        return -1;
+
+    auto library = std::make_unique<Mapping>();
+
+    {
+        juce::MemoryOutputStream stream(library->copy, false);
+
+        stream.writeInt((int)magic);
+        stream.writeShort((short)currentVersion);
+        stream.writeShort((short)numColumns);
+        stream.writeInt(numPresets);
+        stream.writeInt(nameSize + 4 * numColumns);
+
+        for (auto hash : columns)
+            stream.writeInt((int)hash);
+
+        // Existing records keep their values; columns they did not have are
+        // left unset.
+        for (int index = 0; index < view->numPresets; ++index)
+        {
+            stream.write(view->getRecord(index), (size_t)nameSize);
+
+            for (int column = 0; column < numColumns; ++column)
+                stream.writeFloat(column < view->numColumns ? view->getValue(index, column)
+                                                            : std::numeric_limits<float>::quiet_NaN());
+        }
+
+        char newName[nameSize] = {};
+        name.copyToUTF8(newName, (size_t)nameSize);
+        stream.write(newName, (size_t)nameSize);
+
+        for (auto hash : columns)
+        {
+            auto value = std::numeric_limits<float>::quiet_NaN();
+
+            for (auto& target : targets)
+            {
+                if (target.hash == hash)
+                {
+                    value = target.parameter->getValue();
+                    break;
+                }
+            }
+
+            stream.writeFloat(value);
+        }
+    }
+
+    if (! parse(static_cast<const char*>(library->copy.getData()), library->copy.getSize(), library->view))
+        return -1;
+
+    // Readers move over to the copy, and the file is unmapped, before it is
+    // replaced.
+    publish(std::move(library));
+
+    juce::TemporaryFile temp(file);
+    const auto& copy = mapping->copy;
+
+    if (! temp.getFile().replaceWithData(copy.getData(), copy.getSize())
+        || ! temp.overwriteTargetFileWithTemporary())
+    {
+        // The old file is untouched; go back to it.
+        open();
+        return -1;
+    }
+
+    open();
+
+    return getNumPresets() == numPresets ? numPresets - 1 : -1;
+}
+
+void PresetLibrary::reloadIfChanged()
+{
+    const juce::CriticalSection::ScopedLockType lock(writeLock);
+
+    if (file.getLastModificationTime() != lastModified)
+        open();
+}
+
+void PresetLibrary::open()
+{
+    lastModified = file.getLastModificationTime();
+
+    if (! file.existsAsFile())
+        return;
+
+    auto newMapping = std::make_unique<Mapping>();
+    newMapping->file = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    if (! parse(static_cast<const char*>(newMapping->file->getData()), newMapping->file->getSize(), newMapping->view))
+        return;
+
+    publish(std::move(newMapping));
+}
+
+void PresetLibrary::publish(std::unique_ptr<Mapping> newMapping)
+{
+    // Readers count themselves in before loading the view, so once the count
+    // has been seen at zero after the swap, nobody can hold the old one.
+    current.store(&newMapping->view);
+
+    while (readers.load() != 0)
+        std::this_thread::yield();
+
+    mapping = std::move(newMapping);
+
+    sendChangeMessage();
+}
+
+bool PresetLibrary::parse(const char* data, size_t size, View& view) noexcept
+{
+    if (data == nullptr || size < (size_t)headerSize
+        || juce::ByteOrder::littleEndianInt(data) != magic
+        || juce::ByteOrder::littleEndianShort(data + 4) != currentVersion)
+        return false;
+
+    view.numColumns = (int)juce::ByteOrder::littleEndianShort(data + 6);
+    view.numPresets = (int)juce::ByteOrder::littleEndianInt(data + 8);
+    view.recordSize = (int)juce::ByteOrder::littleEndianInt(data + 12);
+    view.columns = data + headerSize;
+    view.records = view.columns + 4 * view.numColumns;
+
+    const auto needed = (juce::uint64)headerSize + 4u * (juce::uint64)view.numColumns
+                      + (juce::uint64)view.numPresets * (juce::uint64)view.recordSize;
+
+    return view.numPresets >= 0 && view.recordSize == nameSize + 4 * view.numColumns && needed <= (juce::uint64)size;
+}
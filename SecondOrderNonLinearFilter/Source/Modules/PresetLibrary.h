@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+    Created: 20 Oct 2026 1:12:08am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PRESETLIBRARY_H_INCLUDED
+#define PRESETLIBRARY_H_INCLUDED
+
+#include <JuceHeader.h>
+
+#include "PluginState.h"
+
+/** A library of presets held in a single memory-mapped file, shared
+    read-only by every instance of the plugin through a
+    juce::SharedResourcePointer.
+
+    Layout, all little-endian:
+
+        uint32  magic ('NLPL')
+        uint16  format version
+        uint16  number of columns, c
+        uint32  number of presets, n
+        uint32  record size, 32 + 4c
+        c x uint32  hash of the parameter ID of each column
+        n x { char name[32], c x float normalised value }
+
+    Records have a fixed stride, so a preset is found by index without
+    scanning or parsing anything, however many the library holds; opening
+    the library only maps the file and checks the header. A value that is
+    not finite marks a column the preset does not set.
+
+    Only one mapping is held at a time. Readers count themselves in and out
+    with an atomic, without waiting; publishing a new view waits for the
+    count to drain before freeing the old one, so nobody is left reading
+    unmapped memory. A save first publishes the new library from memory,
+    which releases the file, and only then replaces the file and maps it
+    again, since a file still mapped cannot be replaced on every platform.
+*/
+class PresetLibrary : public juce::ChangeBroadcaster
+{
+public:
+    /** A parameter of a processor, with the hash of its ID. */
+    struct Target
+    {
+        juce::uint32 hash = 0;
+        juce::AudioProcessorParameter* parameter = nullptr;
+    };
+
+    using Targets = std::vector<Target>;
+
+    //==========================================================================
+    /** Constructor. Opens the library in its default location. */
+    PresetLibrary();
+
+    /** Destructor. */
+    ~PresetLibrary() override;
+
+    /** Where the library is kept. */
+    static juce::File getDefaultFile();
+
+    //==========================================================================
+    /** Lists the parameters of a processor that presets can set, which is all
+    of them but the bypass. Build this once, not on every switch. */
+    static Targets makeTargets(juce::AudioProcessor& processor);
+
+    //==========================================================================
+    /** Returns the number of presets in the library. */
+    int getNumPresets() const noexcept;
+
+    /** Returns the name of a preset, or an empty string if there is no such
+    preset. */
+    juce::String getName(int index) const;
+
+    /** Sets the parameters to the values stored in a preset. Nothing is
+    allocated or parsed, so this may be called from any thread the host uses
+    to change programs. Returns false if there is no such preset. */
+    bool apply(int index, const Targets& targets) const noexcept;
+
+    //==========================================================================
+    /** Adds the current parameter values as a new preset, rewriting the
+    library. Returns the index of the new preset, or -1 if the library could
+    not be written. Message thread only. */
+    int add(const juce::String& name, const Targets& targets);
+
+    /** Maps the library again if another process has rewritten it since it
+    was last opened. Message thread only. */
+    void reloadIfChanged();
+
+private:
+    //==========================================================================
+    /** The parsed header of one mapping of the file. */
+    struct View
+    {
+        const char* columns = nullptr;
+        const char* records = nullptr;
+        int numColumns = 0, numPresets = 0, recordSize = 0;
+
+        const char* getRecord(int index) const noexcept { return records + (size_t)index * (size_t)recordSize; }
+        juce::uint32 getColumn(int column) const noexcept;
+        float getValue(int index, int column) const noexcept;
+    };
+
+    /** The memory a view points into: a mapping of the file, or a copy of
+    the library while the file is being replaced. */
+    struct Mapping
+    {
+        std::unique_ptr<juce::MemoryMappedFile> file;
+        juce::MemoryBlock copy;
+        View view;
+    };
+
+    /** Counts a reader in for as long as it uses the current view. */
+    class ReadScope
+    {
+    public:
+        explicit ReadScope(const PresetLibrary& l) noexcept : library(l) { library.readers.fetch_add(1); }
+        ~ReadScope() noexcept { library.readers.fetch_sub(1); }
+
+        const View& getView() const noexcept { return *library.current.load(); }
+
+    private:
+        const PresetLibrary& library;
+    };
+
+    /** Fills in a view of a library held in memory. Returns false if the
+    header is not valid or the data is too short for it. */
+    static bool parse(const char* data, size_t size, View& view) noexcept;
+
+    /** Maps the file and, if its header is valid, publishes it. */
+    void open();
+
+    /** Makes a mapping current, and frees the previous one once no reader
+    can still be using it. */
+    void publish(std::unique_ptr<Mapping> newMapping);
+
+    //==========================================================================
+    static constexpr juce::uint32 magic = 0x4c504c4e;
+    static constexpr int currentVersion = 1;
+    static constexpr int headerSize = 16, nameSize = 32;
+
+    const juce::File file;
+    juce::Time lastModified;
+
+    std::unique_ptr<Mapping> mapping;
+    const View empty;
+    std::atomic<const View*> current{ &empty };
+    mutable std::atomic<int> readers{ 0 };
+
+    juce::CriticalSection writeLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetLibrary)
+};
+
+#endif //PRESETLIBRARY_H_INCLUDED
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    Saturator.cpp
+    Created: 19 Oct 2026 10:14:22am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "Saturator.h"
+
+template <typename SampleType>
+Saturator<SampleType>::Saturator()
+{
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void Saturator<SampleType>::setAntiAliasing(aaType newAntiAliasing)
+{
+    if (antiAliasing != newAntiAliasing)
+    {
+        antiAliasing = newAntiAliasing;
+        reset();
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void Saturator<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.numChannels > 0);
+
+    Xn_1.resize(spec.numChannels);
+    Xn_2.resize(spec.numChannels);
+    Fn_1.resize(spec.numChannels);
+    Dn_1.resize(spec.numChannels);
+
+    reset();
+}
+
+template <typename SampleType>
+void Saturator<SampleType>::reset()
+{
+    // F1(0), F2(0) and the divided difference about zero are all zero.
+    for (auto v : { &Xn_1, &Xn_2, &Fn_1, &Dn_1 })
+        std::fill(v->begin(), v->end(), 0.0);
+}
+
+template <typename SampleType>
+void Saturator<SampleType>::copyStateFrom(const Saturator& other) noexcept
+{
+    jassert(Xn_1.size() == other.Xn_1.size());
+
+    antiAliasing = other.antiAliasing;
+
+    std::copy(other.Xn_1.begin(), other.Xn_1.end(), Xn_1.begin());
+    std::copy(other.Xn_2.begin(), other.Xn_2.end(), Xn_2.begin());
+    std::copy(other.Fn_1.begin(), other.Fn_1.end(), Fn_1.begin());
+    std::copy(other.Dn_1.begin(), other.Dn_1.end(), Dn_1.begin());
+}
+
+template <typename SampleType>
+void Saturator<SampleType>::snapToZero() noexcept
+{
+    // F1 and F2 of inputs this small are below 1e-16, so zero is the state
+    // that silence would have left.
+    for (size_t channel = 0; channel < Xn_1.size(); ++channel)
+    {
+        if (std::abs(Xn_1[channel]) < snapLevel && std::abs(Xn_2[channel]) < snapLevel)
+        {
+            Xn_1[channel] = 0.0;
+            Xn_2[channel] = 0.0;
+            Fn_1[channel] = 0.0;
+            Dn_1[channel] = 0.0;
+        }
+    }
+}
+
+template class Saturator<float>;
+template class Saturator<double>;
@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    Saturator.h
+    Created: 19 Oct 2026 10:14:22am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SATURATOR_H_INCLUDED
+#define SATURATOR_H_INCLUDED
+
+#include <JuceHeader.h>
+
+enum class AntiAliasingType
+{
+    none = 0,
+    adaa1 = 1,
+    adaa2 = 2
+};
+
+/** A tanh() waveshaper with optional first- or second-order antiderivative
+    anti-aliasing (ADAA).
+
+    ADAA replaces the waveshaper with the average of the curve between
+    neighbouring input samples, which suppresses most of the aliasing that
+    would otherwise need heavy oversampling. The first-order form delays the
+    signal by half a sample and the second-order form by one sample, so when
+    used inside a feedback path it slightly detunes the loop - the output stays
+    bounded by +/-1 either way. The divided differences are evaluated in double
+    precision and fall back to the midpoint value when neighbouring inputs are
+    too close together to be divided safely.
+*/
+template <typename SampleType>
+class Saturator
+{
+public:
+    using aaType = AntiAliasingType;
+    //==============================================================================
+    /** Constructor. */
+    Saturator();
+
+    //==============================================================================
+    /** Sets the anti-aliasing order. See enum for available types. */
+    void setAntiAliasing(aaType newAntiAliasing);
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset();
+
+    /** Copies the state variables of another saturator prepared with the same spec. */
+    void copyStateFrom(const Saturator& other) noexcept;
+
+    /** Rounds the state of each channel to zero once its previous inputs have
+    all decayed below a tiny level. The antiderivative terms are cleared with
+    them, so the divided differences stay consistent. */
+    void snapToZero() noexcept;
+
+    //==============================================================================
+    /** Processes one sample at a time on a given channel. */
+    SampleType processSample(int channel, SampleType inputValue);
+
+private:
+    //==============================================================================
+    double adaa1(int channel, double inputValue);
+    double adaa2(int channel, double inputValue);
+
+    //==============================================================================
+    /** First and second antiderivatives of tanh(). */
+    static double F1(double x) noexcept;
+    static double F2(double x) noexcept;
+
+    //==============================================================================
+    /** Unit-delay objects. */
+    std::vector<double> Xn_1, Xn_2, Fn_1, Dn_1;
+
+    //==========================================================================
+    /** Initialised parameter */
+    aaType antiAliasing = aaType::none;
+
+    //==============================================================================
+    /** Initialise constants. */
+    static constexpr double tolerance1 = 1.0e-5, tolerance2 = 1.0e-4, snapLevel = 1.0e-8;
+    static constexpr double ln2 = 0.69314718055994530942;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Saturator)
+};
+
+//==============================================================================
+/*  The per-sample kernels are defined here rather than in Saturator.cpp, so
+    they inline into the filters' sample loops. */
+
+//==============================================================================
+template <typename SampleType>
+inline SampleType Saturator<SampleType>::processSample(int channel, SampleType inputValue)
+{
+    jassert(juce::isPositiveAndBelow(channel, Xn_1.size()));
+
+    switch (antiAliasing)
+    {
+    case AntiAliasingType::none:
+        return std::tanh(inputValue);
+    case AntiAliasingType::adaa1:
+        return static_cast<SampleType>(adaa1(channel, static_cast<double>(inputValue)));
+    case AntiAliasingType::adaa2:
+        return static_cast<SampleType>(adaa2(channel, static_cast<double>(inputValue)));
+    default:
+        return std::tanh(inputValue);
+    }
+}
+
+template <typename SampleType>
+inline double Saturator<SampleType>::adaa1(int channel, double inputValue)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+    auto& Fn1 = Fn_1[(size_t)channel];
+
+    const auto& Xn = inputValue;
+    const auto Fn = F1(Xn);
+    const auto dX = Xn - Xn1;
+
+    const auto Yn = (std::abs(dX) < tolerance1)
+        ? std::tanh(0.5 * (Xn + Xn1))
+        : (Fn - Fn1) / dX;
+
+    Xn1 = Xn;
+    Fn1 = Fn;
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline double Saturator<SampleType>::adaa2(int channel, double inputValue)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+    auto& Xn2 = Xn_2[(size_t)channel];
+    auto& Fn1 = Fn_1[(size_t)channel];
+    auto& Dn1 = Dn_1[(size_t)channel];
+
+    const auto& Xn = inputValue;
+    const auto Fn = F2(Xn);
+    const auto dX = Xn - Xn1;
+
+    const auto Dn = (std::abs(dX) < tolerance2)
+        ? F1(0.5 * (Xn + Xn1))
+        : (Fn - Fn1) / dX;
+
+    auto Yn = 0.0;
+
+    if (std::abs(Xn - Xn2) < tolerance2)
+    {
+        const auto xBar = 0.5 * (Xn + Xn2);
+        const auto delta = xBar - Xn1;
+
+        Yn = (std::abs(delta) < tolerance2)
+            ? std::tanh(0.5 * (xBar + Xn1))
+            : (2.0 / delta) * (F1(xBar) + ((Fn1 - F2(xBar)) / delta));
+    }
+
+    else
+    {
+        Yn = (2.0 * (Dn - Dn1)) / (Xn - Xn2);
+    }
+
+    Xn2 = Xn1;
+    Xn1 = Xn;
+    Fn1 = Fn;
+    Dn1 = Dn;
+
+    return Yn;
+}
+
+//==============================================================================
+template <typename SampleType>
+inline double Saturator<SampleType>::F1(double x) noexcept
+{
+    // log(cosh(x)), arranged so that it cannot overflow for large inputs.
+    const auto t = std::abs(x);
+
+    return t + std::log1p(std::exp(-2.0 * t)) - ln2;
+}
+
+template <typename SampleType>
+inline double Saturator<SampleType>::F2(double x) noexcept
+{
+    // Integral of log(cosh(t)) from 0 to |x|, which is
+    // x^2/2 - x.ln(2) + Li2(-exp(-2x))/2 + pi^2/24, mirrored for negative x.
+    // The dilogarithm is summed as a Bernoulli series in w = -log(1 + u),
+    // which stays within |w| <= ln(2) and converges to double precision
+    // in nine terms.
+    const auto t = std::abs(x);
+    const auto w = -std::log1p(std::exp(-2.0 * t));
+    const auto s = w * w;
+
+    const auto series = (1.0 / 36.0)
+        + s * ((-1.0 / 3600.0)
+        + s * ((1.0 / 211680.0)
+        + s * ((-1.0 / 10886400.0)
+        + s * ((1.0 / 526901760.0)
+        + s * ((-691.0 / 16999766784000.0)
+        + s * ((1.0 / 1120863744000.0)
+        + s * ((-3617.0 / 181400588328960000.0)
+        + s * (43867.0 / 97072790126247936000.0))))))));
+
+    const auto Li2 = w - (0.25 * s) + (w * s * series);
+
+    const auto pi = juce::MathConstants<double>::pi;
+    const auto G = (0.5 * t * t) - (t * ln2) + (0.5 * Li2) + ((pi * pi) / 24.0);
+
+    return (x < 0.0) ? -G : G;
+}
+
+#endif //SATURATOR_H_INCLUDED
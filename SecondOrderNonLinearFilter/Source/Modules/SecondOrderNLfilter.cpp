@@ -13,8 +13,7 @@
 template <typename SampleType>
 SecondOrderNLfilter<SampleType>::SecondOrderNLfilter() 
     : 
-    b0(one), b1(zero), b2(zero), a0(one), a1(zero), a2(zero),
-    b_0(one), b_1(zero), b_2(zero), a_0(one), a_1(zero), a_2(zero)
+    b0(one), b1(zero), b2(zero), a0(one), a1(zero), a2(zero)
 {
     reset();
 }
@@ -28,12 +27,8 @@ void SecondOrderNLfilter<SampleType>::setFrequency(SampleType newFreq)
     if (hz != newFreq)
     {
         hz = juce::jlimit(minFreq, maxFreq, newFreq);
-
-        omega = (hz * ((pi * two) / static_cast <SampleType>(sampleRate)));
-        cos = (std::cos(omega));
-        sin = (std::sin(omega));
-
-        coefficients();
+        svf.setFrequency(hz);
+        dirty = true;
     }
 }
 
@@ -45,8 +40,8 @@ void SecondOrderNLfilter<SampleType>::setResonance(SampleType newRes)
     if (q != newRes)
     {
         q = juce::jlimit(SampleType(0.0), SampleType(1.0), newRes);
-
-        coefficients();
+        svf.setResonance(q);
+        dirty = true;
     }
 }
 
@@ -56,7 +51,8 @@ void SecondOrderNLfilter<SampleType>::setGain(SampleType newGain)
     if (g != newGain)
     {
         g = newGain;
-        coefficients();
+        svf.setGain(g);
+        dirty = true;
     }
 }
 
@@ -66,8 +62,9 @@ void SecondOrderNLfilter<SampleType>::setFilterType(filterType newFiltType)
     if (filtType != newFiltType)
     {
         filtType = newFiltType;
+        svf.setFilterType(filtType);
         reset();
-        coefficients();
+        dirty = true;
     }
 }
 
@@ -77,178 +74,244 @@ void SecondOrderNLfilter<SampleType>::setSaturationType(satType newTransformType
     if (saturationType != newTransformType)
     {
         saturationType = newTransformType;
+        svf.setSaturationType(saturationType);
         reset();
-        coefficients();
+        dirty = true;
     }
 }
 
-//==============================================================================
 template <typename SampleType>
-void SecondOrderNLfilter<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+void SecondOrderNLfilter<SampleType>::updateCoefficients() noexcept
 {
-    jassert(spec.sampleRate > 0);
-    jassert(spec.numChannels > 0);
+    // The state-variable engine designs its own coefficients; the direct
+    // form's stay dirty until that engine is back in use.
+    if (engine == engineType::stateVariable)
+    {
+        svf.updateCoefficients();
+        return;
+    }
 
-    sampleRate = spec.sampleRate;
+    if (dirty)
+    {
+        dirty = false;
+        coefficients();
+    }
+}
 
-    Wn_1.resize(spec.numChannels);
-    Wn_2.resize(spec.numChannels);
-    Xn_1.resize(spec.numChannels);
-    Xn_2.resize(spec.numChannels);
-    Yn_1.resize(spec.numChannels);
-    Yn_2.resize(spec.numChannels);
+template <typename SampleType>
+void SecondOrderNLfilter<SampleType>::setAntiAliasing(aaType newAntiAliasing)
+{
+    if (antiAliasing != newAntiAliasing)
+    {
+        antiAliasing = newAntiAliasing;
 
-    reset();
+        for (auto sat : { &satB0, &satB1, &satB2, &satA1, &satA2 })
+            sat->setAntiAliasing(antiAliasing);
 
-    minFreq = static_cast <SampleType> (sampleRate / 24576.0);
-    maxFreq = static_cast <SampleType> (sampleRate / 2.125);
+        svf.setAntiAliasing(antiAliasing);
+    }
+}
 
-    jassert(static_cast <SampleType> (20.0) >= minFreq && minFreq <= static_cast <SampleType> (20000.0));
-    jassert(static_cast <SampleType> (20.0) <= maxFreq && maxFreq >= static_cast <SampleType> (20000.0));
+template <typename SampleType>
+void SecondOrderNLfilter<SampleType>::setZeroDelayFeedback(bool shouldUseZdf)
+{
+    if (zdf != shouldUseZdf)
+    {
+        zdf = shouldUseZdf;
+        reset();
+    }
+}
 
-    setFrequency(hz);
-    setResonance(q);
-    setGain(g);
-    setFilterType(filtType);
-    setSaturationType(saturationType);
+template <typename SampleType>
+void SecondOrderNLfilter<SampleType>::setMaxIterations(int newMaxIterations)
+{
+    jassert(newMaxIterations > 0);
 
-    coefficients();
+    maxIterations = juce::jmax(1, newMaxIterations);
 }
 
 template <typename SampleType>
-void SecondOrderNLfilter<SampleType>::reset(SampleType initialValue)
+void SecondOrderNLfilter<SampleType>::setDenormalStrategy(denormalType newStrategy)
 {
-    for (auto v : { &Wn_1, &Wn_2, &Xn_1, &Xn_2, &Yn_1, &Yn_2 })
-        std::fill(v->begin(), v->end(), initialValue);
+    denormalStrategy = newStrategy;
 }
 
 template <typename SampleType>
-SampleType SecondOrderNLfilter<SampleType>::processSample(int channel, SampleType inputValue)
+void SecondOrderNLfilter<SampleType>::setEngine(engineType newEngine)
 {
-    jassert(juce::isPositiveAndBelow(channel, Wn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Wn_2.size()));
-    jassert(juce::isPositiveAndBelow(channel, Xn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Xn_2.size()));
-    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
-
-    switch (saturationType)
+    if (engine != newEngine)
     {
-    case SaturationType::linear:
-        inputValue = linear(channel, inputValue);
-        break;
-    case SaturationType::nonlinear1:
-        inputValue = nonlinear1(channel, inputValue);
-        break;
-    case SaturationType::nonlinear2:
-        inputValue = nonlinear2(channel, inputValue);
-        break;
-    case SaturationType::nonlinear3:
-        inputValue = nonlinear3(channel, inputValue);
-        break;
-    case SaturationType::nonlinear4:
-        inputValue = nonlinear4(channel, inputValue);
-        break;
-    default:
-        inputValue = linear(channel, inputValue);
+        engine = newEngine;
+        reset();
     }
-
-    return inputValue;
 }
 
 template <typename SampleType>
-SampleType SecondOrderNLfilter<SampleType>::linear(int channel, SampleType inputSample)
+void SecondOrderNLfilter<SampleType>::resetSolverStatistics() noexcept
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
-
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
+    iterationCount = 0;
+    solveCount = 0;
+    blockMaxIterations = 0;
+    averageIterations.store(0.0f, std::memory_order_relaxed);
+    maxIterationsUsed.store(0, std::memory_order_relaxed);
+}
 
-    Yn = ((Xn * b0) + (Xn2));
+template <typename SampleType>
+SampleType SecondOrderNLfilter<SampleType>::getDecaySamples(SampleType level, SampleType maxSamples) const noexcept
+{
+    if (engine == engineType::stateVariable)
+    {
+        auto poleA1 = zero, poleA2 = zero;
+        svf.getPoles(poleA1, poleA2);
 
-    Xn2 = ((Xn * b1) + (Xn1) + (Yn * a1));
-    Xn1 = ((Xn * b2) + (Yn * a2));
+        return getDecaySamples({ zero, zero, zero, poleA1, poleA2 }, level, maxSamples);
+    }
 
-    return Yn;
+    return getDecaySamples({ b0.get(), b1.get(), b2.get(), a1.get(), a2.get() }, level, maxSamples);
 }
 
 template <typename SampleType>
-SampleType SecondOrderNLfilter<SampleType>::nonlinear1(int channel, SampleType inputSample)
+SampleType SecondOrderNLfilter<SampleType>::getDecaySamples(const BiquadCoefficients<SampleType>& c, SampleType level, SampleType maxSamples) noexcept
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
+    const SampleType zero = (0.0), one = (+1.0), two = (+2.0), half = (0.5);
+
+    // Poles are the roots of z^2 - a1.z - a2, in the filter's sign convention.
+    const auto A1 = c.a1;
+    const auto A2 = c.a2;
+    const auto disc = (A1 * A1) + (A2 * static_cast<SampleType>(4.0));
+
+    auto radius = zero;
 
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
+    if (disc < zero)
+        radius = std::sqrt(-A2);
+    else
+        radius = (std::abs(A1) + std::sqrt(disc)) * half;
 
-    Yn = (std::tanh(Xn * b0) + (Xn2));
+    if (radius <= zero)
+        return two;
 
-    Xn2 = ((Xn * b1) + (Xn1)+(Yn * a1));
-    Xn1 = ((Xn * b2) + (Yn * a2));
+    if (radius >= one)
+        return maxSamples;
 
-    return Yn;
+    // r^n falls below the level after log(level) / log(r) samples. Real poles
+    // may coincide, so their count is doubled to cover the n.r^n response of
+    // a repeated pole. So is that of complex poles close enough together that
+    // rounding could have put them on either side, which is where the
+    // state-variable engine's critically damped pairs land.
+    const auto isRepeated = disc > static_cast<SampleType>(-64.0) * std::numeric_limits<SampleType>::epsilon();
+    const auto n = (isRepeated ? two : one) * std::log(level) / std::log(radius);
+
+    return juce::jlimit(two, maxSamples, n);
 }
 
 template <typename SampleType>
-SampleType SecondOrderNLfilter<SampleType>::nonlinear2(int channel, SampleType inputSample)
+void SecondOrderNLfilter<SampleType>::setChannelAsleep(int channel, bool shouldSleep) noexcept
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
+    jassert(juce::isPositiveAndBelow(channel, asleep.size()));
 
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
+    asleep[(size_t)channel] = shouldSleep;
+}
 
-    Yn = ((Xn * b0) + (Xn2));
+template <typename SampleType>
+void SecondOrderNLfilter<SampleType>::publishSolverStatistics() noexcept
+{
+    averageIterations.store(static_cast<float>(iterationCount) / static_cast<float>(solveCount), std::memory_order_relaxed);
 
-    Xn2 = (std::tanh(Xn * b1) + (Xn1) + (Yn * a1));
-    Xn1 = (std::tanh(Xn * b2) + (Yn * a2));
+    if (blockMaxIterations > maxIterationsUsed.load(std::memory_order_relaxed))
+        maxIterationsUsed.store(blockMaxIterations, std::memory_order_relaxed);
 
-    return Yn;
+    iterationCount = 0;
+    solveCount = 0;
+    blockMaxIterations = 0;
 }
 
+//==============================================================================
 template <typename SampleType>
-SampleType SecondOrderNLfilter<SampleType>::nonlinear3(int channel, SampleType inputSample)
+void SecondOrderNLfilter<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+
+    Wn_1.resize(spec.numChannels);
+    Wn_2.resize(spec.numChannels);
+    Xn_1.resize(spec.numChannels);
+    Xn_2.resize(spec.numChannels);
+    Yn_1.resize(spec.numChannels);
+    Yn_2.resize(spec.numChannels);
+    asleep.assign(spec.numChannels, false);
 
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
+    for (auto sat : { &satB0, &satB1, &satB2, &satA1, &satA2 })
+        sat->prepare(spec);
 
-    Yn = ((Xn * b0) + (Xn2));
+    svf.prepare(spec);
 
-    Xn2 = ((Xn * b1) + (Xn1) + std::tanh(Yn * a1));
-    Xn1 = ((Xn * b2) + std::tanh(Yn * a2));
+    reset();
 
-    return Yn;
+    minFreq = static_cast <SampleType> (sampleRate / 24576.0);
+    maxFreq = static_cast <SampleType> (sampleRate / 2.125);
+
+    jassert(static_cast <SampleType> (20.0) >= minFreq && minFreq <= static_cast <SampleType> (20000.0));
+    jassert(static_cast <SampleType> (20.0) <= maxFreq && maxFreq >= static_cast <SampleType> (20000.0));
+
+    setFrequency(hz);
+    setResonance(q);
+    setGain(g);
+    setFilterType(filtType);
+    setSaturationType(saturationType);
+
+    dirty = false;
+    coefficients();
 }
 
 template <typename SampleType>
-SampleType SecondOrderNLfilter<SampleType>::nonlinear4(int channel, SampleType inputSample)
+void SecondOrderNLfilter<SampleType>::reset(SampleType initialValue)
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
+    NLFILTER_TRACE_SCOPE(*tracer, "filter reset");
 
-    auto& Xn = inputSample;
-    auto& Yn = outputSample;
-
-    Yn = (std::tanh(Xn * b0) + (Xn2));
+    for (auto v : { &Wn_1, &Wn_2, &Xn_1, &Xn_2, &Yn_1, &Yn_2 })
+        std::fill(v->begin(), v->end(), initialValue);
 
-    Xn2 = (std::tanh(Xn * b1) + (Xn1)+ std::tanh(Yn * a1));
-    Xn1 = (std::tanh(Xn * b2) + std::tanh(Yn * a2));
+    for (auto sat : { &satB0, &satB1, &satB2, &satA1, &satA2 })
+        sat->reset();
 
-    return Yn;
+    svf.reset(initialValue);
 }
 
 template <typename SampleType>
 void SecondOrderNLfilter<SampleType>::coefficients()
 {
-    alpha = (sin * (one - q));
-    a = (std::pow(SampleType(10), (g * SampleType(0.05))));
-    sqrtA = ((std::sqrt(a) * two) * alpha);
+    NLFILTER_TRACE_SCOPE(*tracer, "coefficients");
+
+    const auto c = design(filtType, hz, q, g, sampleRate);
+
+    b0 = c.b0;
+    b1 = c.b1;
+    b2 = c.b2;
+    a0 = one;
+    a1 = c.a1;
+    a2 = c.a2;
+}
+
+template <typename SampleType>
+BiquadCoefficients<SampleType> SecondOrderNLfilter<SampleType>::design(filterType type, SampleType hz, SampleType q, SampleType g, double sampleRate) noexcept
+{
+    const SampleType zero = (0.0), one = (+1.0), two = (+2.0), minusOne = (-1.0), minusTwo = (-2.0);
+    const SampleType pi = (juce::MathConstants<SampleType>::pi);
+
+    const auto omega = (hz * ((pi * two) / static_cast <SampleType>(sampleRate)));
+
+    auto sin = zero, cos = zero;
+    FastMath<SampleType>::sinCos(omega, sin, cos);
 
-    switch (filtType)
+    const auto alpha = (sin * (one - q));
+    const auto a = FastMath<SampleType>::decibelsToGain(g);
+    const auto sqrtA = ((std::sqrt(a) * two) * alpha);
+
+    auto b_0 = one, b_1 = zero, b_2 = zero, a_0 = one, a_1 = zero, a_2 = zero;
+
+    switch (type)
     {
     case filterType::lowPass2:
 
@@ -442,20 +505,107 @@ void SecondOrderNLfilter<SampleType>::coefficients()
         break;
     }
 
-    a0 = (one / a_0);
-    a1 = ((-a_1) * a0);
-    a2 = ((-a_2) * a0);
-    b0 = (b_0 * a0);
-    b1 = (b_1 * a0);
-    b2 = (b_2 * a0);
+    const auto a0 = (one / a_0);
+
+    return { (b_0 * a0), (b_1 * a0), (b_2 * a0), ((-a_1) * a0), ((-a_2) * a0) };
 }
 
 template <typename SampleType>
 void SecondOrderNLfilter<SampleType>::snapToZero() noexcept
 {
-    for (auto v : { &Wn_1, &Wn_2, &Xn_1, &Xn_2, &Yn_1, &Yn_2 })
-        for (auto& element : *v)
-            juce::dsp::util::snapToZero(element);
+    if (engine == engineType::stateVariable)
+    {
+        svf.snapToZero();
+        return;
+    }
+
+    // Written without branches so the compiler can vectorise it.
+    forEachLiveState([this](std::vector<SampleType>& v)
+    {
+        auto* data = v.data();
+
+        for (size_t i = 0; i < v.size(); ++i)
+            data[i] = (std::abs(data[i]) < snapLevel) ? zero : data[i];
+    });
+
+    for (auto* sat : { &satB0, &satB1, &satB2, &satA1, &satA2 })
+        sat->snapToZero();
+}
+
+template <typename SampleType>
+void SecondOrderNLfilter<SampleType>::finishBlock() noexcept
+{
+    if (solveCount > 0)
+        publishSolverStatistics();
+
+    countSubnormals();
+
+    if (denormalStrategy == denormalType::snapToZero)
+        snapToZero();
+}
+
+template <typename SampleType>
+void SecondOrderNLfilter<SampleType>::countSubnormals() noexcept
+{
+    const auto smallest = std::numeric_limits<SampleType>::min();
+    auto count = 0;
+
+    if (engine == engineType::stateVariable)
+        count = svf.countSubnormals();
+    else
+        forEachLiveState([&](std::vector<SampleType>& v)
+        {
+            for (auto element : v)
+                count += (element != zero && std::abs(element) < smallest) ? 1 : 0;
+        });
+
+    if (count > 0)
+        subnormalCount.fetch_add(count, std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void SecondOrderNLfilter<SampleType>::copyStateFrom(const SecondOrderNLfilter& other) noexcept
+{
+    jassert(Xn_1.size() == other.Xn_1.size());
+
+    sampleRate = other.sampleRate;
+    minFreq = other.minFreq;
+    maxFreq = other.maxFreq;
+    hz = other.hz;
+    q = other.q;
+    g = other.g;
+    filtType = other.filtType;
+    saturationType = other.saturationType;
+    antiAliasing = other.antiAliasing;
+    denormalStrategy = other.denormalStrategy;
+    zdf = other.zdf;
+    engine = other.engine;
+    maxIterations = other.maxIterations;
+
+    dirty = other.dirty;
+
+    b0 = other.b0.get();
+    b1 = other.b1.get();
+    b2 = other.b2.get();
+    a0 = other.a0.get();
+    a1 = other.a1.get();
+    a2 = other.a2.get();
+
+    std::copy(other.Wn_1.begin(), other.Wn_1.end(), Wn_1.begin());
+    std::copy(other.Wn_2.begin(), other.Wn_2.end(), Wn_2.begin());
+    std::copy(other.Xn_1.begin(), other.Xn_1.end(), Xn_1.begin());
+    std::copy(other.Xn_2.begin(), other.Xn_2.end(), Xn_2.begin());
+    std::copy(other.Yn_1.begin(), other.Yn_1.end(), Yn_1.begin());
+    std::copy(other.Yn_2.begin(), other.Yn_2.end(), Yn_2.begin());
+    asleep = other.asleep;
+
+    satB0.copyStateFrom(other.satB0);
+    satB1.copyStateFrom(other.satB1);
+    satB2.copyStateFrom(other.satB2);
+    satA1.copyStateFrom(other.satA1);
+    satA2.copyStateFrom(other.satA2);
+
+    svf.copyStateFrom(other.svf);
 }
 
 template class SecondOrderNLfilter<float>;
@@ -16,42 +16,38 @@
 #include <JuceHeader.h>
 
 #include "Coefficient.h"
-
-enum struct FilterType
+#include "Saturator.h"
+#include "FastMath.h"
+#include "TraceRecorder.h"
+#include "FilterTypes.h"
+#include "StateVariableNLfilter.h"
+
+/** Chooses the structure the filter runs. The direct form is the biquad this
+    filter has always been; the state-variable form is the topology-preserving
+    StateVariableNLfilter, which stays well behaved under fast modulation. */
+enum class FilterEngine
 {
-    lowPass2 = 0,
-    lowPass1 = 1,
-    highPass2 = 2,
-    highPass1 = 3,
-    bandPass = 4,
-    bandPassQ = 5,
-    lowShelf2 = 6,
-    lowShelf1 = 7,
-    lowShelf1C = 8,
-    highShelf2 = 9,
-    highShelf1 = 10,
-    highShelf1C = 11,
-    peak = 12,
-    notch = 13,
-    allPass = 14
+    directForm = 0,
+    stateVariable = 1
 };
 
-enum class SaturationType
+/** Normalised biquad coefficients, in the sign convention the filters use:
+    y[n] = b0.x[n] + b1.x[n-1] + b2.x[n-2] + a1.y[n-1] + a2.y[n-2]. */
+template <typename SampleType>
+struct BiquadCoefficients
 {
-    linear = 0,
-    nonlinear1 = 1,
-    nonlinear2 = 2,
-    nonlinear3 = 3,
-    nonlinear4 = 4
+    SampleType b0, b1, b2, a1, a2;
 };
 
-
 template <typename SampleType>
 class SecondOrderNLfilter
 {
 public:
     using filterType = FilterType;
     using satType = SaturationType;
+    using aaType = AntiAliasingType;
+    using denormalType = DenormalStrategy;
+    using engineType = FilterEngine;
     //==============================================================================
     /** Constructor. */
     SecondOrderNLfilter();
@@ -72,6 +68,79 @@ public:
     /** Sets the saturation position for the filter to use. See enum for available types. */
     void setSaturationType(satType newTransformType);
 
+    /** Returns the type of the filter. */
+    filterType getFilterType() const noexcept { return filtType; }
+
+    /** Returns the saturation position of the filter. */
+    satType getSaturationType() const noexcept { return saturationType; }
+
+    /** Redesigns the coefficients if any of the settings above have changed
+    since the last call. process() calls this once per block; call it yourself
+    before using processSample() directly. */
+    void updateCoefficients() noexcept;
+
+    /** Sets the anti-aliasing order of the saturators. See enum for available types. */
+    void setAntiAliasing(aaType newAntiAliasing);
+
+    /** Switches the NL3/NL4 feedback saturation between the explicit one-sample
+    delayed form and an implicit (zero-delay-feedback) form that is solved each
+    sample with Newton-Raphson. */
+    void setZeroDelayFeedback(bool shouldUseZdf);
+
+    /** Sets the maximum number of Newton-Raphson iterations per sample. */
+    void setMaxIterations(int newMaxIterations);
+
+    /** Sets how the recursion is kept out of the denormal range. ftzDaz leaves
+    it to the FTZ/DAZ flags of the calling thread, snapToZero rounds tiny state
+    values to zero after each block, and offset adds an inaudible DC offset to
+    the input so the state never decays that far. The caller's flags are left
+    as they are in every case, so the last two are protection on top of them,
+    for a thread or a platform that runs without. */
+    void setDenormalStrategy(denormalType newStrategy);
+
+    /** Sets the structure the filter runs. The settings above apply to either
+    engine; the zero-delay feedback switch only affects the direct form, as the
+    state-variable form has no delay in its loop to begin with. */
+    void setEngine(engineType newEngine);
+
+    //==============================================================================
+    /** Returns the average number of solver iterations per sample over the last block. */
+    float getAverageIterations() const noexcept { return averageIterations.load(std::memory_order_relaxed); }
+
+    /** Returns the largest number of solver iterations taken by any one sample
+    since the statistics were last reset. */
+    int getMaxIterationsUsed() const noexcept { return maxIterationsUsed.load(std::memory_order_relaxed); }
+
+    /** Resets the solver statistics. */
+    void resetSolverStatistics() noexcept;
+
+    /** Returns the number of subnormal state values seen at the end of a block
+    since the count was last reset. */
+    int getSubnormalCount() const noexcept { return subnormalCount.load(std::memory_order_relaxed); }
+
+    /** Resets the subnormal counter. */
+    void resetSubnormalCount() noexcept { subnormalCount.store(0, std::memory_order_relaxed); }
+
+    //==============================================================================
+    /** Designs the normalised coefficients for the given settings. This is
+    what the filter itself uses, so other processors can share the designs. */
+    static BiquadCoefficients<SampleType> design(filterType type, SampleType frequency, SampleType resonance,
+                                                 SampleType gain, double sampleRate) noexcept;
+
+    //==============================================================================
+    /** Returns the number of samples the impulse response takes to decay below
+    the given level, estimated from the radius of the current poles of
+    whichever engine is in use. Unstable or marginally stable settings return
+    maxSamples. */
+    SampleType getDecaySamples(SampleType level, SampleType maxSamples) const noexcept;
+
+    /** Returns the decay time, as above, of a given set of coefficients. */
+    static SampleType getDecaySamples(const BiquadCoefficients<SampleType>& c, SampleType level, SampleType maxSamples) noexcept;
+
+    /** Puts a channel to sleep, or wakes it up again. A sleeping channel skips
+    processing and outputs silence, holding its state where it left off. */
+    void setChannelAsleep(int channel, bool shouldSleep) noexcept;
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare(juce::dsp::ProcessSpec& spec);
@@ -81,9 +150,15 @@ public:
 
     /** Ensure that the state variables are rounded to zero if the state
     variables are denormals. This is only needed if you are doing sample
-    by sample processing.*/
+    by sample processing. Only the state read by the current structure is
+    touched.*/
     void snapToZero() noexcept;
 
+    /** Copies the parameters, coefficients and state variables of another filter
+    that was prepared with the same spec, so this one carries on exactly where
+    the other one left off. */
+    void copyStateFrom(const SecondOrderNLfilter& other) noexcept;
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context. */
     template <typename ProcessContext>
@@ -97,6 +172,8 @@ public:
         jassert(inputBlock.getNumChannels() == numChannels);
         jassert(inputBlock.getNumSamples() == numSamples);
 
+        updateCoefficients();
+
         if (context.isBypassed)
         {
 
@@ -104,18 +181,97 @@ public:
             return;
         }
 
+        const auto offset = (denormalStrategy == denormalType::offset) ? denormalOffset : zero;
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             auto* inputSamples = inputBlock.getChannelPointer(channel);
             auto* outputSamples = outputBlock.getChannelPointer(channel);
 
+            if (asleep[channel])
+            {
+                std::fill(outputSamples, outputSamples + numSamples, zero);
+                continue;
+            }
+
             for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample((int)channel, inputSamples[i]);
+                outputSamples[i] = processSample((int)channel, inputSamples[i] + offset);
         }
 
-#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
-        snapToZero();
-#endif
+        finishBlock();
+    }
+
+    /** Processes the context with a gain applied on the way into the filter and
+    another on the way out, in a single pass over each channel. The gains are
+    smoothed values that step once per sample; each channel replays the same
+    ramp, and both are advanced past the block on return. */
+    template <typename ProcessContext, typename SmoothedGain>
+    void process(const ProcessContext& context, SmoothedGain& inputGain, SmoothedGain& outputGain) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert(inputBlock.getNumChannels() == numChannels);
+        jassert(inputBlock.getNumSamples() == numSamples);
+
+        updateCoefficients();
+
+        const auto offset = (denormalStrategy == denormalType::offset) ? denormalOffset : zero;
+        const auto isConstant = ! inputGain.isSmoothing() && ! outputGain.isSmoothing();
+
+        if (canProcessLanes(numChannels))
+        {
+            const SampleType* inputs[maxLanes] = {};
+            SampleType* outputs[maxLanes] = {};
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                inputs[channel] = inputBlock.getChannelPointer(channel);
+                outputs[channel] = outputBlock.getChannelPointer(channel);
+            }
+
+            processLanes(inputs, outputs, numChannels, numSamples, inputGain, outputGain, offset);
+        }
+
+        else
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* inputSamples = inputBlock.getChannelPointer(channel);
+                auto* outputSamples = outputBlock.getChannelPointer(channel);
+
+                if (asleep[channel])
+                {
+                    std::fill(outputSamples, outputSamples + numSamples, zero);
+                    continue;
+                }
+
+                if (isConstant)
+                {
+                    const auto inGain = inputGain.getTargetValue();
+                    const auto outGain = outputGain.getTargetValue();
+
+                    for (size_t i = 0; i < numSamples; ++i)
+                        outputSamples[i] = processSample((int)channel, (inputSamples[i] * inGain) + offset) * outGain;
+                }
+
+                else
+                {
+                    auto inRamp = inputGain;
+                    auto outRamp = outputGain;
+
+                    for (size_t i = 0; i < numSamples; ++i)
+                        outputSamples[i] = processSample((int)channel, (inputSamples[i] * inRamp.getNextValue()) + offset) * outRamp.getNextValue();
+                }
+            }
+        }
+
+        inputGain.skip((int)numSamples);
+        outputGain.skip((int)numSamples);
+
+        finishBlock();
     }
 
     //==============================================================================
@@ -140,34 +296,450 @@ private:
     SampleType nonlinear2(int channel, SampleType inputValue);
     SampleType nonlinear3(int channel, SampleType inputValue);
     SampleType nonlinear4(int channel, SampleType inputValue);
+    SampleType nonlinear3zdf(int channel, SampleType inputValue);
+    SampleType nonlinear4zdf(int channel, SampleType inputValue);
+
+    /** Solves the implicit feedback loop for the current output sample. */
+    SampleType solveFeedback(int channel, SampleType feedForward);
+
+    void publishSolverStatistics() noexcept;
+
+    //==============================================================================
+    /** Largest number of channels the lane-parallel kernel runs together.
+    The plugin is mono or stereo, so two lanes cover every layout. */
+    static constexpr int maxLanes = 2;
+
+    /** Returns true if the channels can run together, one per lane: the
+    direct form with explicit feedback, saturators without anti-aliasing (and
+    so without state of their own), and every channel awake. */
+    bool canProcessLanes(size_t numChannels) const noexcept;
+
+    /** Runs every channel at once, at the current saturation position. */
+    template <typename SmoothedGain>
+    void processLanes(const SampleType* const* inputs, SampleType* const* outputs, size_t numChannels,
+                      size_t numSamples, const SmoothedGain& inputGain, const SmoothedGain& outputGain, SampleType offset) noexcept;
+
+    /** The lane-parallel kernel, with one channel per lane and any lane
+    beyond numChannels left idle. */
+    template <SaturationType type, typename SmoothedGain>
+    void laneKernel(const SampleType* const* inputs, SampleType* const* outputs, size_t numChannels,
+                    size_t numSamples, SmoothedGain inRamp, SmoothedGain outRamp, SampleType offset) noexcept;
+
+    /** Per-block housekeeping shared by both process() calls. */
+    void finishBlock() noexcept;
+
+    /** Adds the number of subnormal state values to the counter. */
+    void countSubnormals() noexcept;
+
+    /** Calls fn on each state vector read by the current structure. */
+    template <typename Fn>
+    void forEachLiveState(Fn&& fn) noexcept
+    {
+        const auto directForm = zdf && (saturationType == satType::nonlinear3
+                                     || saturationType == satType::nonlinear4);
+
+        if (directForm)
+            for (auto v : { &Wn_1, &Wn_2, &Yn_1, &Yn_2 })
+                fn(*v);
+        else
+            for (auto v : { &Xn_1, &Xn_2 })
+                fn(*v);
+    }
 
     //==============================================================================
     /** Unit-delay objects. */
     std::vector<SampleType> Wn_1, Wn_2, Xn_1, Xn_2, Yn_1, Yn_2;
 
+    /** Sleeping channels. */
+    std::vector<bool> asleep;
+
+    //==========================================================================
+    /** Saturators, one per coefficient path. */
+    Saturator<SampleType> satB0, satB1, satB2, satA1, satA2;
+
+    /** The state-variable engine, kept in step with the settings. */
+    StateVariableNLfilter<SampleType> svf;
+
     //==========================================================================
     /** Coefficient gain */
     Coefficient<SampleType> b0, b1, b2, a0, a1, a2;
 
-    /** Coefficient calculation */
-    Coefficient<SampleType> b_0, b_1, b_2, a_0, a_1, a_2;
-
     //==========================================================================
     /** Initialised parameter */
     SampleType loop = 0.0, outputSample = 0.0;
     SampleType minFreq = 20.0, maxFreq = 20000.0, hz = 1000.0, q = 0.5, g = 0.0;
     filterType filtType = filterType::lowPass2;
     satType saturationType = satType::linear;
-
-    SampleType omega, cos, sin, tan, alpha, a, sqrtA, omegaDivA, omegaMulA{ 0.0 };
+    aaType antiAliasing = aaType::none;
+    denormalType denormalStrategy = denormalType::ftzDaz;
+    engineType engine = engineType::directForm;
+    bool zdf = false, dirty = false;
+    int maxIterations = 8;
+
+#if NLFILTER_TRACING
+    juce::SharedResourcePointer<TraceRecorder> tracer;
+#endif
 
     //==============================================================================
     /** Initialise constants. */
     const SampleType zero = (0.0), one = (+1.0), two = (+2.0), minusOne = (-1.0), minusTwo = (-2.0);
     const SampleType pi = (juce::MathConstants<SampleType>::pi);
+    const SampleType half = (0.5), tolerance = (1.0e-6);
+    const SampleType snapLevel = (1.0e-8), denormalOffset = (1.0e-15);
     double sampleRate = 48000.0;
 
+    //==============================================================================
+    /** Solver statistics. */
+    int64_t iterationCount = 0, solveCount = 0;
+    int blockMaxIterations = 0;
+    std::atomic<float> averageIterations{ 0.0f };
+    std::atomic<int> maxIterationsUsed{ 0 };
+
+    /** Denormal statistics. */
+    std::atomic<int> subnormalCount{ 0 };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SecondOrderNLfilter)
 };
 
+//==============================================================================
+/*  The per-sample kernels are defined here rather than in SecondOrderNLfilter.cpp,
+    so they inline into process() and the sample loop needs no calls across
+    translation units. */
+
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::processSample(int channel, SampleType inputValue)
+{
+    jassert(juce::isPositiveAndBelow(channel, Wn_1.size()));
+    jassert(juce::isPositiveAndBelow(channel, Wn_2.size()));
+    jassert(juce::isPositiveAndBelow(channel, Xn_1.size()));
+    jassert(juce::isPositiveAndBelow(channel, Xn_2.size()));
+    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
+    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
+
+    if (engine == engineType::stateVariable)
+        return svf.processSample(channel, inputValue);
+
+    switch (saturationType)
+    {
+    case SaturationType::linear:
+        inputValue = linear(channel, inputValue);
+        break;
+    case SaturationType::nonlinear1:
+        inputValue = nonlinear1(channel, inputValue);
+        break;
+    case SaturationType::nonlinear2:
+        inputValue = nonlinear2(channel, inputValue);
+        break;
+    case SaturationType::nonlinear3:
+        inputValue = zdf ? nonlinear3zdf(channel, inputValue) : nonlinear3(channel, inputValue);
+        break;
+    case SaturationType::nonlinear4:
+        inputValue = zdf ? nonlinear4zdf(channel, inputValue) : nonlinear4(channel, inputValue);
+        break;
+    default:
+        inputValue = linear(channel, inputValue);
+    }
+
+    return inputValue;
+}
+
+//==============================================================================
+template <typename SampleType>
+inline bool SecondOrderNLfilter<SampleType>::canProcessLanes(size_t numChannels) const noexcept
+{
+    if (engine != engineType::directForm || antiAliasing != aaType::none || numChannels > (size_t)maxLanes)
+        return false;
+
+    if (zdf && (saturationType == satType::nonlinear3 || saturationType == satType::nonlinear4))
+        return false;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        if (asleep[channel])
+            return false;
+
+    return true;
+}
+
+template <typename SampleType>
+template <typename SmoothedGain>
+inline void SecondOrderNLfilter<SampleType>::processLanes(const SampleType* const* inputs, SampleType* const* outputs, size_t numChannels,
+                                                          size_t numSamples, const SmoothedGain& inputGain, const SmoothedGain& outputGain, SampleType offset) noexcept
+{
+    // A stereo pair is too narrow to gain from a wider instruction set, so
+    // this is left at the baseline.
+    switch (saturationType)
+    {
+    case SaturationType::nonlinear1:
+        laneKernel<SaturationType::nonlinear1>(inputs, outputs, numChannels, numSamples, inputGain, outputGain, offset);
+        break;
+    case SaturationType::nonlinear2:
+        laneKernel<SaturationType::nonlinear2>(inputs, outputs, numChannels, numSamples, inputGain, outputGain, offset);
+        break;
+    case SaturationType::nonlinear3:
+        laneKernel<SaturationType::nonlinear3>(inputs, outputs, numChannels, numSamples, inputGain, outputGain, offset);
+        break;
+    case SaturationType::nonlinear4:
+        laneKernel<SaturationType::nonlinear4>(inputs, outputs, numChannels, numSamples, inputGain, outputGain, offset);
+        break;
+    case SaturationType::linear:
+    default:
+        laneKernel<SaturationType::linear>(inputs, outputs, numChannels, numSamples, inputGain, outputGain, offset);
+        break;
+    }
+}
+
+/*
+    The same transposed direct form II as linear() to nonlinear4(), with the
+    states of every channel gathered into one array per delay. The gain ramps
+    are shared by all channels, so each step is taken once per sample rather
+    than once per channel. The saturators are stateless here, and call the
+    same std::tanh as the per-channel path's, so the output does not move
+    when a block changes path. Two lanes are too few for the compilers here
+    to pack across the feedback loop, so it takes the scalar form.
+*/
+template <typename SampleType>
+template <SaturationType type, typename SmoothedGain>
+inline void SecondOrderNLfilter<SampleType>::laneKernel(const SampleType* const* inputs, SampleType* const* outputs, size_t numChannels,
+                                                        size_t numSamples, SmoothedGain inRamp, SmoothedGain outRamp, SampleType offset) noexcept
+{
+    constexpr auto satB0 = (type == SaturationType::nonlinear1 || type == SaturationType::nonlinear4);
+    constexpr auto satB = (type == SaturationType::nonlinear2 || type == SaturationType::nonlinear4);
+    constexpr auto satA = (type == SaturationType::nonlinear3 || type == SaturationType::nonlinear4);
+
+    using Lanes = std::array<SampleType, (size_t)maxLanes>;
+
+    const SampleType B0 = b0, B1 = b1, B2 = b2, A1 = a1, A2 = a2;
+    Lanes S1{}, S2{}, Xn{};
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        S1[channel] = Xn_1[channel];
+        S2[channel] = Xn_2[channel];
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto inGain = inRamp.getNextValue();
+        const auto outGain = outRamp.getNextValue();
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            Xn[channel] = (inputs[channel][i] * inGain) + offset;
+
+        for (size_t l = 0; l < (size_t)maxLanes; ++l)
+        {
+            auto yb0 = Xn[l] * B0;
+            auto xb1 = Xn[l] * B1, xb2 = Xn[l] * B2;
+
+            if constexpr (satB0)
+                yb0 = std::tanh(yb0);
+
+            if constexpr (satB)
+            {
+                xb1 = std::tanh(xb1);
+                xb2 = std::tanh(xb2);
+            }
+
+            const auto Yn = yb0 + S2[l];
+
+            auto ya1 = Yn * A1, ya2 = Yn * A2;
+
+            if constexpr (satA)
+            {
+                ya1 = std::tanh(ya1);
+                ya2 = std::tanh(ya2);
+            }
+
+            S2[l] = xb1 + S1[l] + ya1;
+            S1[l] = xb2 + ya2;
+            Xn[l] = Yn * outGain;
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            outputs[channel][i] = Xn[channel];
+    }
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        Xn_1[channel] = S1[channel];
+        Xn_2[channel] = S2[channel];
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::linear(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+    auto& Xn2 = Xn_2[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = ((Xn * b0) + (Xn2));
+
+    Xn2 = ((Xn * b1) + (Xn1) + (Yn * a1));
+    Xn1 = ((Xn * b2) + (Yn * a2));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::nonlinear1(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+    auto& Xn2 = Xn_2[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = (satB0.processSample(channel, Xn * b0) + (Xn2));
+
+    Xn2 = ((Xn * b1) + (Xn1)+(Yn * a1));
+    Xn1 = ((Xn * b2) + (Yn * a2));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::nonlinear2(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+    auto& Xn2 = Xn_2[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = ((Xn * b0) + (Xn2));
+
+    Xn2 = (satB1.processSample(channel, Xn * b1) + (Xn1) + (Yn * a1));
+    Xn1 = (satB2.processSample(channel, Xn * b2) + (Yn * a2));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::nonlinear3(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+    auto& Xn2 = Xn_2[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = ((Xn * b0) + (Xn2));
+
+    Xn2 = ((Xn * b1) + (Xn1) + satA1.processSample(channel, Yn * a1));
+    Xn1 = ((Xn * b2) + satA2.processSample(channel, Yn * a2));
+
+    return Yn;
+}
+
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::nonlinear4(int channel, SampleType inputSample)
+{
+    auto& Xn1 = Xn_1[(size_t)channel];
+    auto& Xn2 = Xn_2[(size_t)channel];
+
+    auto& Xn = inputSample;
+    auto& Yn = outputSample;
+
+    Yn = (satB0.processSample(channel, Xn * b0) + (Xn2));
+
+    Xn2 = (satB1.processSample(channel, Xn * b1) + (Xn1)+ satA1.processSample(channel, Yn * a1));
+    Xn1 = (satB2.processSample(channel, Xn * b2) + satA2.processSample(channel, Yn * a2));
+
+    return Yn;
+}
+
+//==============================================================================
+/*
+    The implicit modes run as direct form I, keeping the input history in
+    Wn_1/Wn_2 and the output history in Yn_1/Yn_2. Each feedback tap is split
+    into its linear part and the saturating remainder,
+
+        tanh(v) = v + (tanh(v) - v),
+
+    so that small signals see exactly the linear filter. The remainder of the
+    first feedback tap is evaluated at the midpoint of the previous and the
+    current output, which puts the current output on both sides:
+
+        y = c + phi(a1 * (y + y[n-1]) / 2),     phi(v) = tanh(v) - v
+
+    This is solved with Newton-Raphson, warm-started from the previous output.
+    With |a1| < 2 the residual is monotonic, so the root is unique.
+*/
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::nonlinear3zdf(int channel, SampleType inputSample)
+{
+    auto& Wn1 = Wn_1[(size_t)channel];
+    auto& Wn2 = Wn_2[(size_t)channel];
+
+    auto& Xn = inputSample;
+
+    const auto feedForward = (Xn * b0) + (Wn1 * b1) + (Wn2 * b2);
+
+    Wn2 = Wn1;
+    Wn1 = Xn;
+
+    return solveFeedback(channel, feedForward);
+}
+
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::nonlinear4zdf(int channel, SampleType inputSample)
+{
+    auto& Wn1 = Wn_1[(size_t)channel];
+    auto& Wn2 = Wn_2[(size_t)channel];
+
+    auto& Xn = inputSample;
+
+    const auto feedForward = satB0.processSample(channel, Xn * b0)
+        + satB1.processSample(channel, Wn1 * b1)
+        + satB2.processSample(channel, Wn2 * b2);
+
+    Wn2 = Wn1;
+    Wn1 = Xn;
+
+    return solveFeedback(channel, feedForward);
+}
+
+template <typename SampleType>
+inline SampleType SecondOrderNLfilter<SampleType>::solveFeedback(int channel, SampleType feedForward)
+{
+    auto& Yn1 = Yn_1[(size_t)channel];
+    auto& Yn2 = Yn_2[(size_t)channel];
+
+    const SampleType A1 = a1, A2 = a2;
+
+    auto phi = [](SampleType v) { return std::tanh(v) - v; };
+
+    const auto c = feedForward + (A1 * Yn1) + (A2 * Yn2) + phi(A2 * half * (Yn1 + Yn2));
+
+    auto Yn = Yn1;
+    int iterations = 0;
+
+    while (iterations < maxIterations)
+    {
+        ++iterations;
+
+        const auto t = std::tanh(A1 * half * (Yn + Yn1));
+        const auto residual = Yn - c - (t - (A1 * half * (Yn + Yn1)));
+        const auto slope = juce::jmax(one + (A1 * half * t * t), SampleType(0.25));
+        const auto step = residual / slope;
+
+        Yn -= step;
+
+        if (std::abs(step) <= tolerance * (one + std::abs(Yn)))
+            break;
+    }
+
+    iterationCount += iterations;
+    solveCount += 1;
+    blockMaxIterations = juce::jmax(blockMaxIterations, iterations);
+
+    Yn2 = Yn1;
+    Yn1 = Yn;
+
+    return Yn;
+}
+
 #endif //SECONDORDERNLFILTER_H_INCLUDED
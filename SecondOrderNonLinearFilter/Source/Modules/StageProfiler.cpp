@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+    Created: 19 Oct 2026 11:02:36pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+#if NLFILTER_PROFILING
+
+StageProfiler::StageProfiler()
+    :
+    nanosPerTick(1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond())
+{
+    blockTicks.fill(0);
+    clearHistograms();
+}
+
+const char* StageProfiler::getStageName(int stage) noexcept
+{
+    switch (stage)
+    {
+    case total:         return "Total";
+    case control:       return "Control";
+    case upsampling:    return "Upsample";
+    case filter:        return "Filter";
+    case downsampling:  return "Downsample";
+    case mixer:         return "Mixer";
+    case crossfade:     return "Crossfade";
+    default:            return "";
+    }
+}
+
+//==============================================================================
+void StageProfiler::finishBlock(int numSamples, double sampleRate) noexcept
+{
+    if (resetRequested.exchange(false, std::memory_order_relaxed))
+        clearHistograms();
+
+    // Single writer, so plain loads and stores are enough.
+    auto store = [](auto& atomic, auto value) { atomic.store(value, std::memory_order_relaxed); };
+    auto load = [](const auto& atomic) { return atomic.load(std::memory_order_relaxed); };
+
+    for (size_t stage = 0; stage < (size_t)numStages; ++stage)
+    {
+        const auto nanos = (double)blockTicks[stage] * nanosPerTick;
+        auto& histogram = histograms[stage];
+
+        const auto position = bucketsPerOctave * std::log2(juce::jmax(nanos, firstBucketNanos) / firstBucketNanos);
+        const auto bucket = juce::jmin(numBuckets - 1, (int)std::ceil(position));
+
+        store(histogram.counts[(size_t)bucket], load(histogram.counts[(size_t)bucket]) + 1);
+        store(histogram.totalNanos, load(histogram.totalNanos) + nanos);
+        store(histogram.maxNanos, juce::jmax(load(histogram.maxNanos), nanos));
+
+        blockTicks[stage] = 0;
+    }
+
+    if (sampleRate > 0.0)
+        store(budgetNanos, load(budgetNanos) + 1.0e9 * numSamples / sampleRate);
+
+    numBlocks.store(load(numBlocks) + 1, std::memory_order_release);
+}
+
+//==============================================================================
+StageProfiler::Statistics StageProfiler::getStatistics(int stage) const noexcept
+{
+    Statistics stats;
+
+    const auto blocks = numBlocks.load(std::memory_order_acquire);
+
+    if (blocks == 0 || ! juce::isPositiveAndBelow(stage, (int)numStages))
+        return stats;
+
+    const auto& histogram = histograms[(size_t)stage];
+    const auto totalNanos = histogram.totalNanos.load(std::memory_order_relaxed);
+    const auto budget = budgetNanos.load(std::memory_order_relaxed);
+
+    stats.meanMicroseconds = 0.001 * totalNanos / blocks;
+    stats.maxMicroseconds = 0.001 * histogram.maxNanos.load(std::memory_order_relaxed);
+    stats.budgetPercent = budget > 0.0 ? 100.0 * totalNanos / budget : 0.0;
+
+    // The reader may see a block half filed, so count against the buckets'
+    // own total rather than the block count.
+    juce::uint64 count = 0;
+
+    for (auto& c : histogram.counts)
+        count += c.load(std::memory_order_relaxed);
+
+    const auto target = (juce::uint64)std::ceil(0.99 * (double)count);
+    juce::uint64 cumulative = 0;
+
+    for (int bucket = 0; bucket < numBuckets; ++bucket)
+    {
+        cumulative += histogram.counts[(size_t)bucket].load(std::memory_order_relaxed);
+
+        if (cumulative >= target)
+        {
+            stats.p99Microseconds = 0.001 * juce::jmin(getBucketEdge(bucket), histogram.maxNanos.load(std::memory_order_relaxed));
+            break;
+        }
+    }
+
+    return stats;
+}
+
+//==============================================================================
+double StageProfiler::getBucketEdge(int bucket) noexcept
+{
+    return firstBucketNanos * std::exp2(bucket / bucketsPerOctave);
+}
+
+void StageProfiler::clearHistograms() noexcept
+{
+    for (auto& histogram : histograms)
+    {
+        for (auto& count : histogram.counts)
+            count.store(0, std::memory_order_relaxed);
+
+        histogram.totalNanos.store(0.0, std::memory_order_relaxed);
+        histogram.maxNanos.store(0.0, std::memory_order_relaxed);
+    }
+
+    budgetNanos.store(0.0, std::memory_order_relaxed);
+    numBlocks.store(0, std::memory_order_relaxed);
+}
+
+#endif //NLFILTER_PROFILING
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 19 Oct 2026 11:02:36pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef STAGEPROFILER_H_INCLUDED
+#define STAGEPROFILER_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** Set NLFILTER_PROFILING=1 in the exporter's preprocessor definitions to
+    time each stage of the wrapper. When it is 0 the timers, the profilers and
+    the editor meter are all compiled out. */
+#ifndef NLFILTER_PROFILING
+ #define NLFILTER_PROFILING 0
+#endif
+
+#if NLFILTER_PROFILING
+
+/** Per-block timings of each stage of the processing chain.
+
+    The audio thread accumulates the time spent in each stage over a block,
+    then files the totals into one histogram per stage. The histograms are
+    plain atomics with a single writer, so reading them from the editor never
+    blocks the audio thread. Buckets are spaced a quarter of an octave apart
+    from 100 ns, so the reported p99 is within 19% of the true value.
+*/
+class StageProfiler
+{
+public:
+    enum Stage
+    {
+        total = 0,
+        control,
+        upsampling,
+        filter,
+        downsampling,
+        mixer,
+        crossfade,
+        numStages
+    };
+
+    struct Statistics
+    {
+        double meanMicroseconds = 0.0;
+        double p99Microseconds = 0.0;
+        double maxMicroseconds = 0.0;
+        double budgetPercent = 0.0;
+    };
+
+    /** Times the enclosing scope and adds it to a stage. */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(StageProfiler& p, Stage s) noexcept
+            : profiler(p), stage(s), start(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedTimer() noexcept { profiler.addTicks(stage, juce::Time::getHighResolutionTicks() - start); }
+
+    private:
+        StageProfiler& profiler;
+        const Stage stage;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedTimer)
+    };
+
+    /** Times the enclosing scope as the whole block, and files the block
+    when the scope ends. */
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(StageProfiler& p, int blockSamples, double blockSampleRate) noexcept
+            : timer(std::in_place, p, total), profiler(p), numSamples(blockSamples), sampleRate(blockSampleRate) {}
+
+        ~ScopedBlock() noexcept
+        {
+            timer.reset();
+            profiler.finishBlock(numSamples, sampleRate);
+        }
+
+    private:
+        std::optional<ScopedTimer> timer;
+        StageProfiler& profiler;
+        const int numSamples;
+        const double sampleRate;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    //==========================================================================
+    /** Constructor. */
+    StageProfiler();
+
+    /** Returns a short display name for a stage. */
+    static const char* getStageName(int stage) noexcept;
+
+    //==========================================================================
+    /** Adds time to a stage of the current block. Audio thread only. */
+    void addTicks(Stage stage, juce::int64 ticks) noexcept { blockTicks[(size_t)stage] += ticks; }
+
+    /** Files the current block into the histograms. Audio thread only. */
+    void finishBlock(int numSamples, double sampleRate) noexcept;
+
+    //==========================================================================
+    /** Returns the statistics of a stage since the last reset. Any thread. */
+    Statistics getStatistics(int stage) const noexcept;
+
+    /** Asks the audio thread to clear the histograms at the end of its next block. */
+    void reset() noexcept { resetRequested.store(true, std::memory_order_relaxed); }
+
+private:
+    //==========================================================================
+    static constexpr int numBuckets = 64;
+    static constexpr double firstBucketNanos = 100.0;
+    static constexpr double bucketsPerOctave = 4.0;
+
+    struct Histogram
+    {
+        std::array<std::atomic<juce::uint32>, (size_t)numBuckets> counts;
+        std::atomic<double> totalNanos{ 0.0 };
+        std::atomic<double> maxNanos{ 0.0 };
+    };
+
+    /** Returns the upper edge of a bucket, in nanoseconds. */
+    static double getBucketEdge(int bucket) noexcept;
+
+    void clearHistograms() noexcept;
+
+    //==========================================================================
+    std::array<juce::int64, (size_t)numStages> blockTicks;
+    std::array<Histogram, (size_t)numStages> histograms;
+
+    std::atomic<juce::uint32> numBlocks{ 0 };
+    std::atomic<double> budgetNanos{ 0.0 };
+    std::atomic<bool> resetRequested{ false };
+
+    const double nanosPerTick;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageProfiler)
+};
+
+ #define NLFILTER_PROFILE_BLOCK(profiler, numSamples, sampleRate) \
+    const StageProfiler::ScopedBlock JUCE_JOIN_MACRO(blockTimer, __LINE__)(profiler, numSamples, sampleRate)
+
+ #define NLFILTER_PROFILE_STAGE(profiler, stage) \
+    const StageProfiler::ScopedTimer JUCE_JOIN_MACRO(stageTimer, __LINE__)(profiler, StageProfiler::stage)
+
+#else
+
+ #define NLFILTER_PROFILE_BLOCK(profiler, numSamples, sampleRate)
+ #define NLFILTER_PROFILE_STAGE(profiler, stage)
+
+#endif //NLFILTER_PROFILING
+
+#endif //STAGEPROFILER_H_INCLUDED
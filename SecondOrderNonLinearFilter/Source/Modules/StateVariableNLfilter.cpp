@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+
+    StateVariableNLfilter.cpp
+    Created: 20 Oct 2026 3:05:41am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "StateVariableNLfilter.h"
+
+template <typename SampleType>
+StateVariableNLfilter<SampleType>::StateVariableNLfilter()
+{
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::setFrequency(SampleType newFreq)
+{
+    jassert(minFreq <= newFreq && newFreq <= maxFreq);
+
+    if (hz != newFreq)
+    {
+        hz = juce::jlimit(minFreq, maxFreq, newFreq);
+        dirty = true;
+    }
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::setResonance(SampleType newRes)
+{
+    jassert(zero <= newRes && newRes <= one);
+
+    if (q != newRes)
+    {
+        q = juce::jlimit(zero, one, newRes);
+        dirty = true;
+    }
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::setGain(SampleType newGain)
+{
+    if (g != newGain)
+    {
+        g = newGain;
+        dirty = true;
+    }
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::setFilterType(filterType newFiltType)
+{
+    if (filtType != newFiltType)
+    {
+        filtType = newFiltType;
+        reset();
+        dirty = true;
+    }
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::setSaturationType(satType newTransformType)
+{
+    if (saturationType != newTransformType)
+    {
+        saturationType = newTransformType;
+        reset();
+    }
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::setAntiAliasing(aaType newAntiAliasing)
+{
+    if (antiAliasing != newAntiAliasing)
+    {
+        antiAliasing = newAntiAliasing;
+
+        for (auto sat : { &satX, &satV1, &satV2, &satS1, &satS2 })
+            sat->setAntiAliasing(antiAliasing);
+    }
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::updateCoefficients() noexcept
+{
+    if (dirty)
+    {
+        dirty = false;
+        coefficients();
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+
+    ic1eq.resize(spec.numChannels);
+    ic2eq.resize(spec.numChannels);
+
+    for (auto sat : { &satX, &satV1, &satV2, &satS1, &satS2 })
+        sat->prepare(spec);
+
+    reset();
+
+    minFreq = static_cast <SampleType> (sampleRate / 24576.0);
+    maxFreq = static_cast <SampleType> (sampleRate / 2.125);
+
+    hz = juce::jlimit(minFreq, maxFreq, hz);
+
+    dirty = false;
+    coefficients();
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::reset(SampleType initialValue)
+{
+    for (auto v : { &ic1eq, &ic2eq })
+        std::fill(v->begin(), v->end(), initialValue);
+
+    for (auto sat : { &satX, &satV1, &satV2, &satS1, &satS2 })
+        sat->reset();
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::snapToZero() noexcept
+{
+    for (auto v : { &ic1eq, &ic2eq })
+    {
+        auto* data = v->data();
+
+        for (size_t i = 0; i < v->size(); ++i)
+            data[i] = (std::abs(data[i]) < snapLevel) ? zero : data[i];
+    }
+
+    for (auto* sat : { &satX, &satV1, &satV2, &satS1, &satS2 })
+        sat->snapToZero();
+}
+
+template <typename SampleType>
+int StateVariableNLfilter<SampleType>::countSubnormals() const noexcept
+{
+    const auto smallest = std::numeric_limits<SampleType>::min();
+    auto count = 0;
+
+    for (auto v : { &ic1eq, &ic2eq })
+        for (auto element : *v)
+            count += (element != zero && std::abs(element) < smallest) ? 1 : 0;
+
+    return count;
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::copyStateFrom(const StateVariableNLfilter& other) noexcept
+{
+    jassert(ic1eq.size() == other.ic1eq.size());
+
+    sampleRate = other.sampleRate;
+    minFreq = other.minFreq;
+    maxFreq = other.maxFreq;
+    hz = other.hz;
+    q = other.q;
+    g = other.g;
+    filtType = other.filtType;
+    saturationType = other.saturationType;
+    antiAliasing = other.antiAliasing;
+
+    dirty = other.dirty;
+
+    a1 = other.a1;
+    a2 = other.a2;
+    a3 = other.a3;
+    m0 = other.m0;
+    m1 = other.m1;
+    m2 = other.m2;
+
+    std::copy(other.ic1eq.begin(), other.ic1eq.end(), ic1eq.begin());
+    std::copy(other.ic2eq.begin(), other.ic2eq.end(), ic2eq.begin());
+
+    satX.copyStateFrom(other.satX);
+    satV1.copyStateFrom(other.satV1);
+    satV2.copyStateFrom(other.satV2);
+    satS1.copyStateFrom(other.satS1);
+    satS2.copyStateFrom(other.satS2);
+}
+
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::getPoles(SampleType& poleA1, SampleType& poleA2) const noexcept
+{
+    // The trapezoidal integrators give the denominator
+    // (1 + g.k + g^2).z^2 + 2.(g^2 - 1).z + (1 - g.k + g^2), where
+    // a1 = 1 / (1 + g.k + g^2) and g = a2 / a1.
+    const auto gw = a2 / a1;
+    const auto gg = gw * gw;
+
+    poleA1 = two * (one - gg) * a1;
+    poleA2 = one - two * a1 * (one + gg);
+}
+
+//==============================================================================
+template <typename SampleType>
+void StateVariableNLfilter<SampleType>::coefficients() noexcept
+{
+    // Resonance maps to damping as it does to alpha in the direct form's
+    // design, so both engines have the same Q for the same setting.
+    const auto a = FastMath<SampleType>::decibelsToGain(g);
+    const auto aa = a * a;
+
+    const auto w = pi * hz / static_cast<SampleType>(sampleRate);
+    auto k = two * (one - q);
+    auto scale = one;
+    auto firstOrder = false;
+
+    switch (filtType)
+    {
+    case filterType::lowPass2:
+        m0 = zero;
+        m1 = zero;
+        m2 = one;
+        break;
+
+    case filterType::lowPass1:
+        firstOrder = true;
+        k = two;
+        m0 = zero;
+        m1 = one;
+        m2 = one;
+        break;
+
+    case filterType::highPass2:
+        m0 = one;
+        m1 = -k;
+        m2 = -one;
+        break;
+
+    case filterType::highPass1:
+        firstOrder = true;
+        k = two;
+        m0 = one;
+        m1 = -one;
+        m2 = -one;
+        break;
+
+    case filterType::bandPass:
+        m0 = zero;
+        m1 = one;
+        m2 = zero;
+        break;
+
+    case filterType::bandPassQ:
+        m0 = zero;
+        m1 = k;
+        m2 = zero;
+        break;
+
+    case filterType::lowShelf2:
+        scale = one / std::sqrt(a);
+        m0 = one;
+        m1 = k * (a - one);
+        m2 = aa - one;
+        break;
+
+    case filterType::lowShelf1:
+        firstOrder = true;
+        k = two;
+        m0 = one;
+        m1 = aa - one;
+        m2 = aa - one;
+        break;
+
+    case filterType::lowShelf1C:
+        firstOrder = true;
+        scale = one / a;
+        k = two;
+        m0 = one;
+        m1 = aa - one;
+        m2 = aa - one;
+        break;
+
+    case filterType::highShelf2:
+        scale = std::sqrt(a);
+        m0 = aa;
+        m1 = k * (one - a) * a;
+        m2 = one - aa;
+        break;
+
+    case filterType::highShelf1:
+        firstOrder = true;
+        k = two;
+        m0 = aa;
+        m1 = one - aa;
+        m2 = one - aa;
+        break;
+
+    case filterType::highShelf1C:
+        firstOrder = true;
+        scale = a;
+        k = two;
+        m0 = aa;
+        m1 = one - aa;
+        m2 = one - aa;
+        break;
+
+    case filterType::peak:
+        k = k / a;
+        m0 = one;
+        m1 = k * (aa - one);
+        m2 = zero;
+        break;
+
+    case filterType::notch:
+        m0 = one;
+        m1 = -k;
+        m2 = zero;
+        break;
+
+    case filterType::allPass:
+        m0 = one;
+        m1 = -two * k;
+        m2 = zero;
+        break;
+
+    default:
+        m0 = one;
+        m1 = zero;
+        m2 = zero;
+        break;
+    }
+
+    // The first-order types follow the direct form's design, which maps the
+    // cutoff as 2.pi.fc / fs without prewarping; the rest are prewarped.
+    auto gw = two * w;
+
+    if (! firstOrder)
+    {
+        auto sin = zero, cos = zero;
+        FastMath<SampleType>::sinCos(w, sin, cos);
+        gw = sin / cos;
+    }
+
+    gw = gw * scale;
+
+    a1 = one / (one + gw * (gw + k));
+    a2 = gw * a1;
+    a3 = gw * a2;
+}
+
+template class StateVariableNLfilter<float>;
+template class StateVariableNLfilter<double>;
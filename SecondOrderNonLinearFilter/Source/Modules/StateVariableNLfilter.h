@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    StateVariableNLfilter.h
+    Created: 20 Oct 2026 3:05:41am
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef STATEVARIABLENLFILTER_H_INCLUDED
+#define STATEVARIABLENLFILTER_H_INCLUDED
+
+#include <JuceHeader.h>
+
+#include "Saturator.h"
+#include "FastMath.h"
+#include "FilterTypes.h"
+
+/** A topology-preserving (trapezoidal) state-variable filter, offering the
+    same responses and saturation positions as SecondOrderNLfilter.
+
+    The two integrators are solved together each sample, so there is no delay
+    in the feedback loop and the state stays meaningful however quickly the
+    settings move; the cutoff costs at most one tan() per update. Every
+    response is a mix of the input and the band-pass and low-pass outputs,
+
+        y = m0.x + m1.v1 + m2.v2,
+
+    with the first-order types taken from a critically damped (k = 2) pair,
+    whose second pole cancels against a zero of the mix.
+
+    The saturation positions follow those of the direct form: NL1 drives the
+    input, NL2 the band-pass and low-pass taps into the mix, NL3 the integrator
+    states, and NL4 all three.
+*/
+template <typename SampleType>
+class StateVariableNLfilter
+{
+public:
+    using filterType = FilterType;
+    using satType = SaturationType;
+    using aaType = AntiAliasingType;
+    //==============================================================================
+    /** Constructor. */
+    StateVariableNLfilter();
+
+    //==============================================================================
+    /** Sets the centre Frequency of the filter. Range = 20..20000 */
+    void setFrequency(SampleType newFreq);
+
+    /** Sets the resonance of the filter. Range = 0..1 */
+    void setResonance(SampleType newRes);
+
+    /** Sets the centre Frequency gain of the filter. Peak and shelf modes only. */
+    void setGain(SampleType newGain);
+
+    /** Sets the type of the filter. See enum for available types. */
+    void setFilterType(filterType newFiltType);
+
+    /** Sets the saturation position for the filter to use. See enum for available types. */
+    void setSaturationType(satType newTransformType);
+
+    /** Sets the anti-aliasing order of the saturators. See enum for available types. */
+    void setAntiAliasing(aaType newAntiAliasing);
+
+    /** Recomputes the coefficients if any of the settings above have changed
+    since the last call. Call this before processSample(). */
+    void updateCoefficients() noexcept;
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset(SampleType initialValue = {0.0});
+
+    /** Rounds integrator states, and saturator histories, in the denormal
+    range to zero. */
+    void snapToZero() noexcept;
+
+    /** Returns the number of integrator states in the subnormal range. */
+    int countSubnormals() const noexcept;
+
+    /** Returns the poles of the current coefficients as the roots of
+    z^2 - poleA1.z - poleA2, the direct form's denominator. */
+    void getPoles(SampleType& poleA1, SampleType& poleA2) const noexcept;
+
+    /** Copies the settings, coefficients and state of another filter that was
+    prepared with the same spec. */
+    void copyStateFrom(const StateVariableNLfilter& other) noexcept;
+
+    //==============================================================================
+    /** Processes one sample at a time on a given channel. */
+    SampleType processSample(int channel, SampleType inputValue) noexcept;
+
+private:
+    //==============================================================================
+    void coefficients() noexcept;
+
+    /** One step of the filter, with saturation at the chosen positions. */
+    template <bool saturateInput, bool saturateTaps, bool saturateStates>
+    SampleType tick(int channel, SampleType inputValue) noexcept;
+
+    //==============================================================================
+    /** Integrator states. */
+    std::vector<SampleType> ic1eq, ic2eq;
+
+    //==========================================================================
+    /** Saturators, one per position. */
+    Saturator<SampleType> satX, satV1, satV2, satS1, satS2;
+
+    //==========================================================================
+    /** Coefficients. */
+    SampleType a1 = 1.0, a2 = 0.0, a3 = 0.0, m0 = 1.0, m1 = 0.0, m2 = 0.0;
+
+    //==========================================================================
+    /** Initialised parameter */
+    SampleType minFreq = 20.0, maxFreq = 20000.0, hz = 1000.0, q = 0.5, g = 0.0;
+    filterType filtType = filterType::lowPass2;
+    satType saturationType = satType::linear;
+    aaType antiAliasing = aaType::none;
+    bool dirty = false;
+
+    //==============================================================================
+    /** Initialise constants. */
+    const SampleType zero = (0.0), one = (+1.0), two = (+2.0);
+    const SampleType pi = (juce::MathConstants<SampleType>::pi);
+    const SampleType snapLevel = (1.0e-8);
+    double sampleRate = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StateVariableNLfilter)
+};
+
+//==============================================================================
+/*  The per-sample kernels are defined here rather than in StateVariableNLfilter.cpp,
+    so they inline into the calling filter's sample loop. */
+
+template <typename SampleType>
+inline SampleType StateVariableNLfilter<SampleType>::processSample(int channel, SampleType inputValue) noexcept
+{
+    jassert(juce::isPositiveAndBelow(channel, ic1eq.size()));
+    jassert(juce::isPositiveAndBelow(channel, ic2eq.size()));
+
+    switch (saturationType)
+    {
+    case SaturationType::linear:
+        return tick<false, false, false>(channel, inputValue);
+    case SaturationType::nonlinear1:
+        return tick<true, false, false>(channel, inputValue);
+    case SaturationType::nonlinear2:
+        return tick<false, true, false>(channel, inputValue);
+    case SaturationType::nonlinear3:
+        return tick<false, false, true>(channel, inputValue);
+    case SaturationType::nonlinear4:
+        return tick<true, true, true>(channel, inputValue);
+    default:
+        return tick<false, false, false>(channel, inputValue);
+    }
+}
+
+/*
+    With g = tan(pi.fc / fs) and damping k, the trapezoidal integrators give
+
+        v1 = a1.ic1 + a2.(x - ic2)
+        v2 = ic2 + a2.ic1 + a3.(x - ic2)
+
+    where a1 = 1 / (1 + g.(g + k)), a2 = g.a1, a3 = g.a2, after which each
+    state moves on to 2.v - ic. Saturating the states bounds them, and since
+    the loop is solved before they are updated, NL3 needs no iteration.
+*/
+template <typename SampleType>
+template <bool saturateInput, bool saturateTaps, bool saturateStates>
+inline SampleType StateVariableNLfilter<SampleType>::tick(int channel, SampleType inputValue) noexcept
+{
+    auto& s1 = ic1eq[(size_t)channel];
+    auto& s2 = ic2eq[(size_t)channel];
+
+    const auto Xn = saturateInput ? satX.processSample(channel, inputValue) : inputValue;
+
+    const auto v3 = Xn - s2;
+    const auto v1 = (a1 * s1) + (a2 * v3);
+    const auto v2 = s2 + (a2 * s1) + (a3 * v3);
+
+    s1 = saturateStates ? satS1.processSample(channel, (two * v1) - s1) : (two * v1) - s1;
+    s2 = saturateStates ? satS2.processSample(channel, (two * v2) - s2) : (two * v2) - s2;
+
+    const auto bp = saturateTaps ? satV1.processSample(channel, v1) : v1;
+    const auto lp = saturateTaps ? satV2.processSample(channel, v2) : v2;
+
+    return (m0 * Xn) + (m1 * bp) + (m2 * lp);
+}
+
+#endif //STATEVARIABLENLFILTER_H_INCLUDED
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 19 Oct 2026 11:47:15pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+#if NLFILTER_TRACING
+
+TraceRecorder::TraceRecorder()
+    :
+    juce::Thread("Trace Export"),
+    slots(new Slot[(size_t)capacity])
+{
+    pendingEvents.reserve((size_t)capacity);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stopThread(5000);
+}
+
+//==============================================================================
+void TraceRecorder::record(const char* name, char phase, float value) noexcept
+{
+    const auto index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots[(size_t)(index & (capacity - 1))];
+
+    // Odd while being written, then 2.(index + 1) once complete.
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const auto thread = (juce::uint64)reinterpret_cast<juce::pointer_sized_uint>(juce::Thread::getCurrentThreadId());
+
+    slot.ticks.store(juce::Time::getHighResolutionTicks(), std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.threadId.store((juce::uint32)(thread ^ (thread >> 32)) & 0x7fffffff, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+void TraceRecorder::snapshot(std::vector<Event>& events) const
+{
+    events.clear();
+
+    const auto end = writeIndex.load(std::memory_order_acquire);
+    const auto start = end > (juce::uint64)capacity ? end - (juce::uint64)capacity : 0;
+
+    for (auto index = start; index < end; ++index)
+    {
+        const auto& slot = slots[(size_t)(index & (capacity - 1))];
+
+        // Skip slots still being written, or already overwritten.
+        if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2)
+            continue;
+
+        Event event;
+        event.ticks = slot.ticks.load(std::memory_order_relaxed);
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.threadId = slot.threadId.load(std::memory_order_relaxed);
+        event.value = slot.value.load(std::memory_order_relaxed);
+        event.phase = slot.phase.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.sequence.load(std::memory_order_relaxed) == 2 * index + 2)
+            events.push_back(event);
+    }
+
+    // Writers on different threads can land slightly out of order.
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event& a, const Event& b) { return a.ticks < b.ticks; });
+}
+
+//==============================================================================
+bool TraceRecorder::exportTo(const juce::File& file)
+{
+    if (isThreadRunning())
+        return false;
+
+    snapshot(pendingEvents);
+    pendingFile = file;
+
+    return startThread();
+}
+
+void TraceRecorder::run()
+{
+    const auto microsPerTick = 1.0e6 / (double)juce::Time::getHighResolutionTicksPerSecond();
+    const auto origin = pendingEvents.empty() ? 0 : pendingEvents.front().ticks;
+
+    pendingFile.deleteFile();
+    juce::FileOutputStream stream(pendingFile);
+
+    if (! stream.openedOk())
+        return;
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    for (size_t i = 0; i < pendingEvents.size() && ! threadShouldExit(); ++i)
+    {
+        const auto& event = pendingEvents[i];
+        const auto timestamp = (double)(event.ticks - origin) * microsPerTick;
+
+        stream << (i > 0 ? ",\n" : "")
+               << "{\"name\":\"" << event.name << "\""
+               << ",\"ph\":\"" << juce::String::charToString((juce::juce_wchar)event.phase) << "\""
+               << ",\"ts\":" << juce::String(timestamp, 3)
+               << ",\"pid\":1,\"tid\":" << (int)event.threadId;
+
+        if (event.phase == 'i')
+            stream << ",\"s\":\"g\",\"args\":{\"value\":" << juce::String(event.value, 6) << "}";
+
+        stream << "}";
+    }
+
+    stream << "\n]}\n";
+    stream.flush();
+}
+
+#endif //NLFILTER_TRACING
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    Created: 19 Oct 2026 11:47:15pm
+    Author:  StoneyDSP
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef TRACERECORDER_H_INCLUDED
+#define TRACERECORDER_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/** Set NLFILTER_TRACING=1 in the exporter's preprocessor definitions to
+    record a timeline of the processing. When it is 0 the recorder and every
+    trace point are compiled out. */
+#ifndef NLFILTER_TRACING
+ #define NLFILTER_TRACING 0
+#endif
+
+#if NLFILTER_TRACING
+
+/** A flight recorder of timestamped events, shared by every object in the
+    plugin through a juce::SharedResourcePointer.
+
+    Events go into a preallocated ring that any thread can write to without
+    locking: each writer claims a slot with one atomic increment and stamps
+    it with a sequence number once it is filled, overwriting the oldest
+    events once the ring has wrapped. exportTo() hands a snapshot of the ring
+    to a background thread, which writes it out in the Chrome trace event
+    format (chrome://tracing, ui.perfetto.dev).
+
+    Event names must be string literals, or otherwise outlive the recorder.
+*/
+class TraceRecorder : private juce::Thread
+{
+public:
+    //==========================================================================
+    /** Constructor. */
+    TraceRecorder();
+
+    /** Destructor. */
+    ~TraceRecorder() override;
+
+    //==========================================================================
+    /** Records the start of a span on the calling thread. */
+    void begin(const char* name) noexcept { record(name, 'B', 0.0f); }
+
+    /** Records the end of a span on the calling thread. */
+    void end(const char* name) noexcept { record(name, 'E', 0.0f); }
+
+    /** Records a point event carrying a value, such as a parameter change. */
+    void instant(const char* name, float value) noexcept { record(name, 'i', value); }
+
+    //==========================================================================
+    /** Writes the recorded events to a file on a background thread. Returns
+    false if an earlier export is still being written. Message thread only. */
+    bool exportTo(const juce::File& file);
+
+    /** Records a span for the lifetime of the enclosing scope. */
+    class ScopedSpan
+    {
+    public:
+        ScopedSpan(TraceRecorder& r, const char* n) noexcept : recorder(r), name(n) { recorder.begin(name); }
+        ~ScopedSpan() noexcept { recorder.end(name); }
+
+    private:
+        TraceRecorder& recorder;
+        const char* const name;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedSpan)
+    };
+
+private:
+    //==========================================================================
+    struct Event
+    {
+        juce::int64 ticks = 0;
+        const char* name = nullptr;
+        juce::uint32 threadId = 0;
+        float value = 0.0f;
+        char phase = 0;
+    };
+
+    struct Slot
+    {
+        std::atomic<juce::uint64> sequence{ 0 };
+        std::atomic<juce::int64> ticks{ 0 };
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<juce::uint32> threadId{ 0 };
+        std::atomic<float> value{ 0.0f };
+        std::atomic<char> phase{ 0 };
+    };
+
+    //==========================================================================
+    void record(const char* name, char phase, float value) noexcept;
+
+    /** Copies every complete event out of the ring, oldest first. */
+    void snapshot(std::vector<Event>& events) const;
+
+    /** Background thread: writes pendingEvents to pendingFile. */
+    void run() override;
+
+    //==========================================================================
+    static constexpr int capacity = 1 << 16;
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<juce::uint64> writeIndex{ 0 };
+
+    std::vector<Event> pendingEvents;
+    juce::File pendingFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceRecorder)
+};
+
+ #define NLFILTER_TRACE_SCOPE(recorder, name) \
+    const TraceRecorder::ScopedSpan JUCE_JOIN_MACRO(traceSpan, __LINE__)(recorder, name)
+
+ #define NLFILTER_TRACE_INSTANT(recorder, name, value) (recorder).instant(name, value)
+
+#else
+
+ #define NLFILTER_TRACE_SCOPE(recorder, name)
+ #define NLFILTER_TRACE_INSTANT(recorder, name, value)
+
+#endif //NLFILTER_TRACING
+
+#endif //TRACERECORDER_H_INCLUDED
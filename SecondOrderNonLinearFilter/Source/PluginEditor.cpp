@@ -14,11 +14,31 @@ SecondOrderNonLinearFilterAudioProcessorEditor::SecondOrderNonLinearFilterAudioP
     :
     juce::AudioProcessorEditor(&p),
     audioProcessor(p),
-    subComponents(p, p.getAPVTS())
+    subComponents(p, p.getAPVTS(), { "equaliserID", "splitGroupID" }),
+    spectrumAnalyser(p.getPreparedSampleRate(), p.getInputAnalyser(), p.getOutputAnalyser()),
+    responseCurve(p.getPreparedSampleRate(), p.getAPVTS()),
+    presetBrowser(p, p.getPresetLibrary(), [this](const juce::String& name) { return audioProcessor.savePreset(name); }),
+    equaliserPanel(p.getAPVTS()),
+    splitPanel(p.getAPVTS())
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
     addAndMakeVisible(subComponents);
+    addAndMakeVisible(spectrumAnalyser);
+    addAndMakeVisible(responseCurve);
+    addAndMakeVisible(presetBrowser);
+    addAndMakeVisible(equaliserPanel);
+    addAndMakeVisible(splitPanel);
+#if NLFILTER_PROFILING
+    addAndMakeVisible(profilerMeter);
+#endif
+    addAndMakeVisible(storeAButton);
+    addAndMakeVisible(storeBButton);
+    addAndMakeVisible(clearMorphButton);
+    storeAButton.onClick = [this] { audioProcessor.getMorphSnapshots().store(MorphSnapshots::slotA, audioProcessor.getAPVTS()); };
+    storeBButton.onClick = [this] { audioProcessor.getMorphSnapshots().store(MorphSnapshots::slotB, audioProcessor.getAPVTS()); };
+    clearMorphButton.onClick = [this] { audioProcessor.getMorphSnapshots().clear(); };
+
     addAndMakeVisible(undoButton);
     addAndMakeVisible(redoButton);
     undoButton.onClick = [this] { audioProcessor.getUndoManager().undo(); };
@@ -26,23 +46,55 @@ SecondOrderNonLinearFilterAudioProcessorEditor::SecondOrderNonLinearFilterAudioP
     undoButton.setColour(juce::ArrowButton::buttonNormal, juce::Colours::darkgrey);
     undoButton.setColour(juce::ArrowButton::buttonOver, juce::Colours::lightslategrey);
     undoButton.setColour(juce::ArrowButton::buttonDown, juce::Colours::wheat);
-    setResizable(true, true);
-    setSize(530, 350);
 
-    startTimerHz(60);
+#if NLFILTER_TRACING
+    // Written to the desktop, for chrome://tracing or ui.perfetto.dev.
+    addAndMakeVisible(traceButton);
+    traceButton.onClick = [this]
+    {
+        audioProcessor.exportTrace(juce::File::getSpecialLocation(juce::File::userDesktopDirectory)
+                                       .getNonexistentChildFile("NonLinearFilterTrace", ".json"));
+    };
+#endif
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+    // Everything is composited on the GPU; painting only happens on demand.
+    openGLContext.setComponentPaintingEnabled(true);
+    openGLContext.attachTo(*this);
+#endif
+
+    setResizable(true, true);
+#if NLFILTER_PROFILING
+    setSize(600, 680 + ProfilerMeter::preferredHeight);
+#else
+    setSize(600, 670);
+#endif
 }
 
 SecondOrderNonLinearFilterAudioProcessorEditor::~SecondOrderNonLinearFilterAudioProcessorEditor()
 {
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+    openGLContext.detach();
+#endif
 }
 
-void SecondOrderNonLinearFilterAudioProcessorEditor::timerCallback()
+//==============================================================================
+void SecondOrderNonLinearFilterAudioProcessorEditor::paint (juce::Graphics& g)
 {
+    g.drawImage(background, getLocalBounds().toFloat());
 }
 
-//==============================================================================
-void SecondOrderNonLinearFilterAudioProcessorEditor::paint (juce::Graphics& g)
+void SecondOrderNonLinearFilterAudioProcessorEditor::renderBackground()
 {
+    const auto scale = juce::Component::getApproximateScaleFactorForComponent(this);
+
+    background = juce::Image(juce::Image::RGB,
+                             juce::jmax(1, juce::roundToInt(getWidth() * scale)),
+                             juce::jmax(1, juce::roundToInt(getHeight() * scale)), false);
+
+    juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll(juce::Colours::blueviolet);
 
@@ -62,9 +114,29 @@ void SecondOrderNonLinearFilterAudioProcessorEditor::resized()
 {
     // This is generally where you'll want to lay out the positions of any
     // subcomponents in your editor..
-    subComponents.setBounds(0, 0, getWidth(), getHeight());
+    renderBackground();
+
+    auto height = getHeight();
+
+#if NLFILTER_PROFILING
+    profilerMeter.setBounds(20, height - 25 - ProfilerMeter::preferredHeight, getWidth() - 40, ProfilerMeter::preferredHeight);
+    height -= ProfilerMeter::preferredHeight + 10;
+#endif
+
+    subComponents.setBounds(0, 0, getWidth(), height - 320);
+    equaliserPanel.setBounds(20, height - 315, getWidth() - 40, 90);
+    splitPanel.setBounds(20, height - 225, getWidth() - 40, 90);
+    spectrumAnalyser.setBounds(20, height - 130, getWidth() - 40, 100);
+    responseCurve.setBounds(spectrumAnalyser.getBounds());
+    presetBrowser.setBounds((getWidth() / 2) - 120, 25, 240, 22);
+    storeAButton.setBounds((getWidth() / 2) - 95, 52, 60, 20);
+    storeBButton.setBounds((getWidth() / 2) - 30, 52, 60, 20);
+    clearMorphButton.setBounds((getWidth() / 2) + 35, 52, 60, 20);
     undoButton.setBounds((getWidth() / 2) - 10, getHeight() - 20, 20, 20);
     redoButton.setBounds((getWidth() / 2) + 10, getHeight() - 20, 20, 20);
+#if NLFILTER_TRACING
+    traceButton.setBounds(getWidth() - 110, getHeight() - 22, 100, 20);
+#endif
     subComponents.resized();
     undoButton.resized();
     redoButton.resized();
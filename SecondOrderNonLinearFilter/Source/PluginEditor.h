@@ -11,11 +11,17 @@
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "PluginProcessor.h"
 #include "Components/AutoComponent.h"
+#include "Components/ResponseCurve.h"
+#include "Components/SpectrumAnalyser.h"
+#include "Components/ProfilerMeter.h"
+#include "Components/PresetBrowser.h"
+#include "Components/EqualiserPanel.h"
+#include "Components/SplitPanel.h"
 
 //==============================================================================
 /**
 */
-class SecondOrderNonLinearFilterAudioProcessorEditor  : public juce::AudioProcessorEditor, public juce::Timer
+class SecondOrderNonLinearFilterAudioProcessorEditor  : public juce::AudioProcessorEditor
 {
 public:
     using APVTS = juce::AudioProcessorValueTreeState;
@@ -24,19 +30,42 @@ public:
     ~SecondOrderNonLinearFilterAudioProcessorEditor() override;
 
     //==============================================================================
-    void timerCallback() override;
     void paint (juce::Graphics&) override;
     void resized() override;
 
 private:
+    /** Draws the static background into an image, so paint() only blits it. */
+    void renderBackground();
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     SecondOrderNonLinearFilterAudioProcessor& audioProcessor;
 
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+    juce::OpenGLContext openGLContext;
+#endif
+
+    juce::Image background;
+
     AutoComponent subComponents;
+    SpectrumAnalyser spectrumAnalyser;
+    ResponseCurve responseCurve;
+    PresetBrowser presetBrowser;
+    EqualiserPanel equaliserPanel;
+    SplitPanel splitPanel;
+
+#if NLFILTER_PROFILING
+    ProfilerMeter profilerMeter{ [this]() -> StageProfiler& { return audioProcessor.getProfiler(); } };
+#endif
+
+    juce::TextButton storeAButton{ "Store A" }, storeBButton{ "Store B" }, clearMorphButton{ "Clear" };
 
     juce::ArrowButton undoButton{ "Undo", 0.5f , juce::Colours::white };
     juce::ArrowButton redoButton{ "Redo", 0.0f , juce::Colours::white };
 
+#if NLFILTER_TRACING
+    juce::TextButton traceButton{ "Export Trace" };
+#endif
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SecondOrderNonLinearFilterAudioProcessorEditor)
 };
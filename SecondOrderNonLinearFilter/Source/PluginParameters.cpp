@@ -15,6 +15,16 @@ Parameters::Parameters(SecondOrderNonLinearFilterAudioProcessor& p) : audioProce
 {
 }
 
+juce::String Parameters::getBandID(int band, const juce::String& setting)
+{
+    return "band" + juce::String(band + 1) + setting + "ID";
+}
+
+juce::String Parameters::getSplitID(int band, const juce::String& setting)
+{
+    return "split" + juce::String(band + 1) + setting + "ID";
+}
+
 void Parameters::setParameterLayout(Params& params)
 {
     const auto dBMax = juce::Decibels::gainToDecibels(16.0f);
@@ -30,6 +40,10 @@ void Parameters::setParameterLayout(Params& params)
     const auto fString = juce::StringArray({ "LP2", "LP1", "HP2", "HP1" , "BP2", "BP2c", "LS2", "LS1c", "LS1", "HS2", "HS1c", "HS1", "PK2", "NX2", "AP2" });
     const auto tString = juce::StringArray({ "Linear", "NL1", "NL2", "NL3", "NL4" });
     const auto osString = juce::StringArray({ "--", "2x", "4x", "8x", "16x" });
+    const auto aaString = juce::StringArray({ "--", "ADAA1", "ADAA2" });
+    const auto dnString = juce::StringArray({ "FTZ", "Snap", "Offset" });
+    const auto eString = juce::StringArray({ "DF", "SVF" });
+    const auto sString = juce::StringArray({ "--", "2", "3", "4" });
 
     const auto decibels = juce::String{ ("dB") };
     const auto frequency = juce::String{ ("Hz") };
@@ -73,7 +87,9 @@ void Parameters::setParameterLayout(Params& params)
             std::make_unique<juce::AudioParameterFloat>("gainID", "Shelf +/-", gainRange, 00.00f, gainAttributes),
             std::make_unique<juce::AudioParameterFloat>("driveID", "Drive", gainRange, 00.00f, gainAttributes),
             std::make_unique<juce::AudioParameterChoice>("typeID", "Type", fString, 0),
-            std::make_unique<juce::AudioParameterChoice>("linearityID", "Saturation", tString, 0)
+            std::make_unique<juce::AudioParameterChoice>("linearityID", "Saturation", tString, 0),
+            std::make_unique<juce::AudioParameterBool>("zdfID", "ZDF", false),
+            std::make_unique<juce::AudioParameterChoice>("engineID", "Engine", eString, 0)
             //==================================================================
             ));
 
@@ -82,8 +98,52 @@ void Parameters::setParameterLayout(Params& params)
         (std::make_unique<juce::AudioProcessorParameterGroup>("masterID", "1", "seperatorB",
             //==================================================================
             std::make_unique<juce::AudioParameterChoice>("osID", "Oversampling", osString, 0),
+            std::make_unique<juce::AudioParameterChoice>("aaID", "Anti-alias", aaString, 0),
+            std::make_unique<juce::AudioParameterChoice>("denormalID", "Denormals", dnString, 0),
             std::make_unique<juce::AudioParameterFloat>("outputID", "Output", outputRange, 00.00f, outputAttributes),
-            std::make_unique<juce::AudioParameterFloat>("mixID", "Mix", mixRange, 100.00f, mixAttributes)
+            std::make_unique<juce::AudioParameterFloat>("mixID", "Mix", mixRange, 100.00f, mixAttributes),
+            std::make_unique<juce::AudioParameterFloat>("morphID", "Morph", mixRange, 00.00f, mixAttributes)
             //==================================================================
             ));
+
+    //==========================================================================
+    /** Equaliser bands, spread over the spectrum as peaks, all off. */
+    const float bandFrequencies[numBands] = { 60.0f, 150.0f, 400.0f, 1000.0f, 2500.0f, 5000.0f, 10000.0f, 15000.0f };
+
+    auto equaliser = std::make_unique<juce::AudioProcessorParameterGroup>("equaliserID", "2", "seperatorC");
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const auto name = "Band " + juce::String(band + 1) + " ";
+
+        equaliser->addChild(std::make_unique<juce::AudioParameterBool>(getBandID(band, "Enabled"), name + "On", false));
+        equaliser->addChild(std::make_unique<juce::AudioParameterFloat>(getBandID(band, "Frequency"), name + "Frequency", freqRange, bandFrequencies[band], freqAttributes));
+        equaliser->addChild(std::make_unique<juce::AudioParameterFloat>(getBandID(band, "Resonance"), name + "Resonance", resRange, 00.50f, resAttributes));
+        equaliser->addChild(std::make_unique<juce::AudioParameterFloat>(getBandID(band, "Gain"), name + "Gain", gainRange, 00.00f, gainAttributes));
+        equaliser->addChild(std::make_unique<juce::AudioParameterChoice>(getBandID(band, "Type"), name + "Type", fString, 12));
+        equaliser->addChild(std::make_unique<juce::AudioParameterChoice>(getBandID(band, "Linearity"), name + "Saturation", tString, 0));
+    }
+
+    params.add(std::move(equaliser));
+
+    //==========================================================================
+    /** Multiband split, off by default. Crossover N sits above band N. */
+    const float crossoverFrequencies[numSplits - 1] = { 200.0f, 1000.0f, 5000.0f };
+
+    auto split = std::make_unique<juce::AudioProcessorParameterGroup>("splitGroupID", "3", "seperatorD");
+
+    split->addChild(std::make_unique<juce::AudioParameterChoice>("splitID", "Split Bands", sString, 0));
+
+    for (int band = 0; band < numSplits - 1; ++band)
+        split->addChild(std::make_unique<juce::AudioParameterFloat>(getSplitID(band, "Crossover"), "Crossover " + juce::String(band + 1), freqRange, crossoverFrequencies[band], freqAttributes));
+
+    for (int band = 0; band < numSplits; ++band)
+    {
+        const auto name = "Split " + juce::String(band + 1) + " ";
+
+        split->addChild(std::make_unique<juce::AudioParameterFloat>(getSplitID(band, "Drive"), name + "Drive", gainRange, 00.00f, gainAttributes));
+        split->addChild(std::make_unique<juce::AudioParameterChoice>(getSplitID(band, "Linearity"), name + "Saturation", tString, 0));
+    }
+
+    params.add(std::move(split));
 }
\ No newline at end of file
@@ -30,6 +30,21 @@ public:
     /** Create Parameter Layout. */
     static void setParameterLayout(Params& params);
 
+    //==========================================================================
+    /** Number of equaliser bands. */
+    static constexpr int numBands = 8;
+
+    /** Returns the ID of a setting of an equaliser band, such as
+    getBandID(0, "Frequency") for "band1FrequencyID". */
+    static juce::String getBandID(int band, const juce::String& setting);
+
+    /** Largest number of bands of the multiband split. */
+    static constexpr int numSplits = 4;
+
+    /** Returns the ID of a setting of a band of the multiband split, such as
+    getSplitID(0, "Drive") for "split1DriveID". */
+    static juce::String getSplitID(int band, const juce::String& setting);
+
 private:
     //==========================================================================
     // This reference is provided as a quick way for the wrapper to
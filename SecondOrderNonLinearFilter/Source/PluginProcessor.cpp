@@ -20,9 +20,9 @@ SecondOrderNonLinearFilterAudioProcessor::SecondOrderNonLinearFilterAudioProcess
     parameters(*this),
     processorFloat(*this),
     processorDouble(*this),
-    bypassState(dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("bypassID"))),
-    processingPrecision(singlePrecision)
+    bypassState(dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("bypassID")))
 {
+    presetTargets = PresetLibrary::makeTargets(*this);
 }
 
 SecondOrderNonLinearFilterAudioProcessor::~SecondOrderNonLinearFilterAudioProcessor()
@@ -51,30 +51,76 @@ void SecondOrderNonLinearFilterAudioProcessor::setBypassParameter(juce::AudioPar
 
 }
 
+int SecondOrderNonLinearFilterAudioProcessor::getSubnormalCount() const noexcept
+{
+    return isUsingDoublePrecision() ? processorDouble.getSubnormalCount() : processorFloat.getSubnormalCount();
+}
+
+float SecondOrderNonLinearFilterAudioProcessor::getAverageIterations() const noexcept
+{
+    return isUsingDoublePrecision() ? processorDouble.getAverageIterations() : processorFloat.getAverageIterations();
+}
+
+int SecondOrderNonLinearFilterAudioProcessor::getMaxIterationsUsed() const noexcept
+{
+    return isUsingDoublePrecision() ? processorDouble.getMaxIterationsUsed() : processorFloat.getMaxIterationsUsed();
+}
+
+void SecondOrderNonLinearFilterAudioProcessor::setMaxIterations(int newMaxIterations) noexcept
+{
+    processorFloat.setMaxIterations(newMaxIterations);
+    processorDouble.setMaxIterations(newMaxIterations);
+}
+
+int SecondOrderNonLinearFilterAudioProcessor::savePreset(const juce::String& name)
+{
+    const auto index = presets->add(name, presetTargets);
+
+    if (index >= 0)
+    {
+        currentProgram.store(index);
+        updateHostDisplay();
+    }
+
+    return index;
+}
+
+#if NLFILTER_PROFILING
+StageProfiler& SecondOrderNonLinearFilterAudioProcessor::getProfiler() noexcept
+{
+    return isUsingDoublePrecision() ? processorDouble.getProfiler() : processorFloat.getProfiler();
+}
+#endif
+
+#if NLFILTER_TRACING
+bool SecondOrderNonLinearFilterAudioProcessor::exportTrace(const juce::File& file)
+{
+    return tracer->exportTo(file);
+}
+#endif
+
 bool SecondOrderNonLinearFilterAudioProcessor::supportsDoublePrecisionProcessing() const
 {
-    return false;
+    return true;
 }
 
+// The host sets the precision through juce::AudioProcessor, so these all
+// defer to it rather than keeping a copy that the host never sees.
 juce::AudioProcessor::ProcessingPrecision SecondOrderNonLinearFilterAudioProcessor::getProcessingPrecision() const noexcept
 {
-    return processingPrecision;
+    return juce::AudioProcessor::getProcessingPrecision();
 }
 
 bool SecondOrderNonLinearFilterAudioProcessor::isUsingDoublePrecision() const noexcept
 {
-    return processingPrecision == doublePrecision;
+    return juce::AudioProcessor::isUsingDoublePrecision();
 }
 
 void SecondOrderNonLinearFilterAudioProcessor::setProcessingPrecision(ProcessingPrecision newPrecision) noexcept
 {
-    // If you hit this assertion then you're trying to use double precision
-    // processing on a processor which does not support it!
-    jassert(newPrecision != doublePrecision || supportsDoublePrecisionProcessing());
-
-    if (processingPrecision != newPrecision)
+    if (getProcessingPrecision() != newPrecision)
     {
-        processingPrecision = newPrecision;
+        juce::AudioProcessor::setProcessingPrecision(newPrecision);
         releaseResources();
         reset();
     }
@@ -103,33 +149,35 @@ bool SecondOrderNonLinearFilterAudioProcessor::isMidiEffect() const
 
 double SecondOrderNonLinearFilterAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return isUsingDoublePrecision() ? processorDouble.getTailLengthSeconds() : processorFloat.getTailLengthSeconds();
 }
 
 int SecondOrderNonLinearFilterAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if the library is empty.
+    return juce::jmax(1, presets->getNumPresets());
 }
 
 int SecondOrderNonLinearFilterAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram.load();
 }
 
 void SecondOrderNonLinearFilterAudioProcessor::setCurrentProgram (int index)
 {
-    juce::ignoreUnused(index);
+    if (presets->apply(index, presetTargets))
+        currentProgram.store(index);
 }
 
 const juce::String SecondOrderNonLinearFilterAudioProcessor::getProgramName (int index)
 {
-    juce::ignoreUnused(index);
-    return {};
+    return presets->getName(index);
 }
 
 void SecondOrderNonLinearFilterAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // The library is shared read-only; presets are added, not renamed.
     juce::ignoreUnused(index, newName);
 }
 
@@ -141,14 +189,31 @@ void SecondOrderNonLinearFilterAudioProcessor::prepareToPlay (double sampleRate,
 
     juce::ignoreUnused(sampleRate, samplesPerBlock);
 
-    processingPrecision = getProcessingPrecision();
-
     spec.sampleRate = getSampleRate();
     spec.maximumBlockSize = getBlockSize();
     spec.numChannels = getTotalNumInputChannels();
 
+    preparedSampleRate.store(spec.sampleRate, std::memory_order_release);
+
     processorFloat.prepare(getSpec());
     processorDouble.prepare(getSpec());
+
+    // Both precisions start with the same latency; after this, the one that
+    // is processing reports any change from processBlock().
+    jassert(processorFloat.getLatencySamples() == processorDouble.getLatencySamples());
+    latencySamples = isUsingDoublePrecision() ? processorDouble.getLatencySamples() : processorFloat.getLatencySamples();
+    setLatencySamples(latencySamples);
+}
+
+void SecondOrderNonLinearFilterAudioProcessor::updateLatency(int newLatencySamples)
+{
+    // Only an actual change is passed on; the host reacts to the notification
+    // in its own time.
+    if (newLatencySamples != latencySamples)
+    {
+        latencySamples = newLatencySamples;
+        setLatencySamples(latencySamples);
+    }
 }
 
 void SecondOrderNonLinearFilterAudioProcessor::releaseResources()
@@ -178,6 +243,10 @@ bool SecondOrderNonLinearFilterAudioProcessor::isBusesLayoutSupported (const Bus
 
 void SecondOrderNonLinearFilterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    NLFILTER_TRACE_SCOPE(*tracer, "processBlock");
+
+    inputAnalyser.push(buffer);
+
     if (bypassState->get())
     {
         processBlockBypassed(buffer, midiMessages);
@@ -185,14 +254,23 @@ void SecondOrderNonLinearFilterAudioProcessor::processBlock(juce::AudioBuffer<fl
 
     else
     {
+        // FTZ/DAZ stay on whatever the denormal strategy; the snap and the
+        // offset only add to them.
         juce::ScopedNoDenormals noDenormals;
 
         processorFloat.process(buffer, midiMessages);
+        updateLatency(processorFloat.getLatencySamples());
     }
+
+    outputAnalyser.push(buffer);
 }
 
 void SecondOrderNonLinearFilterAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
 {
+    NLFILTER_TRACE_SCOPE(*tracer, "processBlock");
+
+    inputAnalyser.push(buffer);
+
     if (bypassState->get())
     {
         processBlockBypassed(buffer, midiMessages);
@@ -200,10 +278,15 @@ void SecondOrderNonLinearFilterAudioProcessor::processBlock(juce::AudioBuffer<do
 
     else
     {
+        // FTZ/DAZ stay on whatever the denormal strategy; the snap and the
+        // offset only add to them.
         juce::ScopedNoDenormals noDenormals;
 
         processorDouble.process(buffer, midiMessages);
+        updateLatency(processorDouble.getLatencySamples());
     }
+
+    outputAnalyser.push(buffer);
 }
 
 void SecondOrderNonLinearFilterAudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
@@ -257,21 +340,30 @@ juce::AudioProcessorValueTreeState::ParameterLayout SecondOrderNonLinearFilterAu
 //==============================================================================
 void SecondOrderNonLinearFilterAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    juce::MemoryBlock morph;
+    morphSnapshots.writeTo(morph);
+    PluginState::write(*this, destData, morph);
 }
 
 void SecondOrderNonLinearFilterAudioProcessor::getCurrentProgramStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    juce::MemoryBlock morph;
+    morphSnapshots.writeTo(morph);
+    PluginState::write(*this, destData, morph);
 }
 
 
 void SecondOrderNonLinearFilterAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
+    juce::MemoryBlock morph;
+
+    if (PluginState::read(*this, data, sizeInBytes, &morph))
+    {
+        morphSnapshots.readFrom(morph.getData(), morph.getSize());
+        return;
+    }
+
+    // States saved before the binary format were XML.
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
     if (xmlState.get() != nullptr)
@@ -281,6 +373,15 @@ void SecondOrderNonLinearFilterAudioProcessor::setStateInformation(const void* d
 
 void SecondOrderNonLinearFilterAudioProcessor::setCurrentProgramStateInformation(const void* data, int sizeInBytes)
 {
+    juce::MemoryBlock morph;
+
+    if (PluginState::read(*this, data, sizeInBytes, &morph))
+    {
+        morphSnapshots.readFrom(morph.getData(), morph.getSize());
+        return;
+    }
+
+    // States saved before the binary format were XML.
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
     if (xmlState.get() != nullptr)
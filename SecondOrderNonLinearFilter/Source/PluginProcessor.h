@@ -12,6 +12,10 @@
 
 #include "PluginParameters.h"
 #include "PluginWrapper.h"
+#include "Modules/AnalyserFifo.h"
+#include "Modules/PluginState.h"
+#include "Modules/PresetLibrary.h"
+#include "Modules/MorphSnapshots.h"
 
 //==============================================================================
 /**
@@ -29,6 +33,53 @@ public:
     bool isBypassed() const noexcept;
     void setBypassParameter(juce::AudioParameterBool* newBypass) noexcept;
 
+    //==========================================================================
+    /** Returns the number of subnormal filter states seen since playback was prepared. */
+    int getSubnormalCount() const noexcept;
+
+    /** Returns the average number of zero-delay feedback solver iterations per
+    sample over the last block. */
+    float getAverageIterations() const noexcept;
+
+    /** Returns the largest number of solver iterations taken by any one sample
+    since playback was prepared. */
+    int getMaxIterationsUsed() const noexcept;
+
+    /** Sets the maximum number of solver iterations per sample, for both
+    precisions. Safe to call from any thread. */
+    void setMaxIterations(int newMaxIterations) noexcept;
+
+    //==========================================================================
+    /** Samples before and after the filter, for the editor's spectrum display. */
+    AnalyserFifo& getInputAnalyser() noexcept { return inputAnalyser; }
+    AnalyserFifo& getOutputAnalyser() noexcept { return outputAnalyser; }
+
+    /** The sample rate playback was last prepared at, or 0. Unlike
+    getSampleRate(), safe to read from any thread. */
+    const std::atomic<double>& getPreparedSampleRate() const noexcept { return preparedSampleRate; }
+
+    //==========================================================================
+    /** The preset library shared by every instance. */
+    PresetLibrary& getPresetLibrary() noexcept { return *presets; }
+
+    /** Adds the current settings to the preset library and selects them.
+    Returns the new program index, or -1 if the library could not be written. */
+    int savePreset(const juce::String& name);
+
+    /** The A and B settings that the morph parameter moves between. */
+    MorphSnapshots& getMorphSnapshots() noexcept { return morphSnapshots; }
+
+#if NLFILTER_PROFILING
+    /** Returns the stage timings of whichever precision is processing. */
+    StageProfiler& getProfiler() noexcept;
+#endif
+
+#if NLFILTER_TRACING
+    /** Writes the recorded trace to a Chrome trace file, in the background.
+    Returns false if an earlier export is still running. */
+    bool exportTrace(const juce::File& file);
+#endif
+
     //==========================================================================
     bool supportsDoublePrecisionProcessing() const override;
     ProcessingPrecision getProcessingPrecision() const noexcept;
@@ -90,11 +141,26 @@ public:
     juce::dsp::ProcessSpec& getSpec() { return spec; };
 
 private:
+    //==========================================================================
+    /** Tells the host about a new latency, after the chain has applied a
+    change of oversampling factor or of split. Audio thread only. */
+    void updateLatency(int newLatencySamples);
+
     //==========================================================================
     /** Audio processor members. */
     Parameters parameters;
+    MorphSnapshots morphSnapshots;
     ProcessWrapper<float> processorFloat;
     ProcessWrapper<double> processorDouble;
+    AnalyserFifo inputAnalyser, outputAnalyser;
+
+    juce::SharedResourcePointer<PresetLibrary> presets;
+    PresetLibrary::Targets presetTargets;
+    std::atomic<int> currentProgram{ 0 };
+
+#if NLFILTER_TRACING
+    juce::SharedResourcePointer<TraceRecorder> tracer;
+#endif
 
     //==========================================================================
     /** Parameter pointers. */
@@ -104,8 +170,8 @@ private:
     //==========================================================================
     /** Init variables. */
     double currentSampleRate = 0;
+    std::atomic<double> preparedSampleRate{ 0.0 };
     int blockSize = 0, latencySamples = 0;
-    ProcessingPrecision processingPrecision = singlePrecision;
 
     //==========================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SecondOrderNonLinearFilterAudioProcessor)
@@ -11,46 +11,115 @@
 #include "PluginWrapper.h"
 #include "PluginProcessor.h"
 
+#if NLFILTER_TRACING
+namespace
+{
+    /** Trace event names, in the order of ProcessWrapper::ParameterIndex. */
+    const char* const parameterTraceNames[] = { "frequency", "resonance", "gain", "drive", "type", "linearity",
+                                                "zdf", "engine", "oversampling", "anti-aliasing", "denormals", "output", "mix", "morph", "split" };
+}
+#endif
+
 template <typename SampleType>
 ProcessWrapper<SampleType>::ProcessWrapper(SecondOrderNonLinearFilterAudioProcessor& p)
     :
     audioProcessor (p),
     state (p.getAPVTS()),
     setup (p.getSpec()),
+    snapshots (p.getMorphSnapshots()),
     frequencyPtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("frequencyID"))),
     resonancePtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("resonanceID"))),
     gainPtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("gainID"))),
     typePtr ( dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("typeID"))),
     linearityPtr ( dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("linearityID"))),
+    zdfPtr ( dynamic_cast <juce::AudioParameterBool*> (p.getAPVTS().getParameter("zdfID"))),
+    enginePtr ( dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("engineID"))),
     osPtr ( dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("osID"))),
+    aaPtr ( dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("aaID"))),
+    denormalPtr ( dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("denormalID"))),
     outputPtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("outputID"))),
     mixPtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("mixID"))),
     bypassPtr ( dynamic_cast <juce::AudioParameterBool*> (p.getAPVTS().getParameter("bypassID"))),
-    drivePtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("driveID")))
+    drivePtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("driveID"))),
+    morphPtr ( dynamic_cast <juce::AudioParameterFloat*> (p.getAPVTS().getParameter("morphID"))),
+    splitPtr ( dynamic_cast <juce::AudioParameterChoice*> (p.getAPVTS().getParameter("splitID")))
 {
     jassert(frequencyPtr != nullptr);
     jassert(resonancePtr != nullptr);
     jassert(gainPtr != nullptr);
     jassert(typePtr != nullptr);
     jassert(linearityPtr != nullptr);
+    jassert(zdfPtr != nullptr);
+    jassert(enginePtr != nullptr);
     jassert(osPtr != nullptr);
+    jassert(aaPtr != nullptr);
+    jassert(denormalPtr != nullptr);
     jassert(outputPtr != nullptr);
     jassert(mixPtr != nullptr);
     jassert(bypassPtr != nullptr);
     jassert(drivePtr != nullptr);
+    jassert(morphPtr != nullptr);
+    jassert(splitPtr != nullptr);
+
+    parameters = { frequencyPtr, resonancePtr, gainPtr, drivePtr, typePtr, linearityPtr,
+                   zdfPtr, enginePtr, osPtr, aaPtr, denormalPtr, outputPtr, mixPtr, morphPtr, splitPtr };
+
+    for (int band = 0; band < Parameters::numSplits; ++band)
+    {
+        if (band < Parameters::numSplits - 1)
+            parameters[(size_t)(firstCrossoverIndex + band)] = p.getAPVTS().getParameter(Parameters::getSplitID(band, "Crossover"));
+
+        parameters[(size_t)(firstSplitDriveIndex + band)] = p.getAPVTS().getParameter(Parameters::getSplitID(band, "Drive"));
+        parameters[(size_t)(firstSplitLinearityIndex + band)] = p.getAPVTS().getParameter(Parameters::getSplitID(band, "Linearity"));
+    }
+
+    const char* const bandSettings[] = { "Enabled", "Frequency", "Resonance", "Gain", "Type", "Linearity" };
+
+    for (int band = 0; band < Parameters::numBands; ++band)
+    {
+        for (int setting = 0; setting < numBandSettings; ++setting)
+        {
+            auto& parameter = parameters[(size_t)(firstBandIndex + (band * numBandSettings) + setting)];
+            parameter = p.getAPVTS().getParameter(Parameters::getBandID(band, bandSettings[setting]));
+            jassert(parameter != nullptr);
+        }
+    }
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        queues[i].clear(parameters[i]->convertFrom0to1(parameters[i]->getValue()));
+        parameters[i]->addListener(this);
+    }
 
     auto osFilter = juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple;
 
+    // Whole-sample latencies, so two factors can be padded out to the same
+    // latency while they crossfade.
     for (int i = 0; i < 5; ++i)
+    {
         oversampler[i] = std::make_unique<juce::dsp::Oversampling<SampleType>>
-        (audioProcessor.getTotalNumInputChannels(), i, osFilter, true, false);
+        (audioProcessor.getTotalNumInputChannels(), i, osFilter, true, true);
+
+        osLatency[i] = juce::roundToInt(oversampler[i]->getLatencyInSamples());
+    }
 
     reset();
 }
 
+template <typename SampleType>
+ProcessWrapper<SampleType>::~ProcessWrapper()
+{
+    for (auto* parameter : parameters)
+        parameter->removeListener(this);
+}
+
 template <typename SampleType>
 void ProcessWrapper<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
 {
+    for (size_t i = 0; i < parameters.size(); ++i)
+        queues[i].clear(parameters[i]->convertFrom0to1(parameters[i]->getValue()));
+
+    curOS = osChoice = juce::roundToInt(queues[osIndex].getLatest());
     oversamplingFactor = 1 << curOS;
     prevOS = curOS;
 
@@ -60,28 +129,77 @@ void ProcessWrapper<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
     for (int i = 0; i < 5; ++i)
         oversampler[i]->numChannels = (size_t)spec.numChannels;
 
+    const auto maxLatency = *std::max_element(std::begin(osLatency), std::end(osLatency));
+
+    for (int i = 0; i < 5; ++i)
+        padding[i].prepare(spec, maxLatency - osLatency[i]);
+
     mixer.prepare(spec);
-    driveUp.prepare(spec);
+    multiband.prepare(spec);
     filter.prepare(spec);
-    driveDn.prepare(spec);
-    output.prepare(spec);
+    fadeFilter.prepare(spec);
+    morphFilter.prepare(spec);
+
+    for (auto* f : { &filter, &fadeFilter, &morphFilter })
+    {
+        f->resetSubnormalCount();
+        f->resetSolverStatistics();
+    }
+
+    appliedIterations = 0;
+    equaliser.setOversamplingFactor(oversamplingFactor);
+    fadeEqualiser.setOversamplingFactor(oversamplingFactor);
+    equaliser.prepare(spec);
+    fadeEqualiser.prepare(spec);
+
+    fadeBuffer.setSize((int)spec.numChannels, (int)spec.maximumBlockSize << 4);
+    silentSamples.assign(spec.numChannels, 0);
+    fade.reset(spec.sampleRate, fadeSeconds);
+
+    // Sized for the highest oversampling factor.
+    morphBuffer.setSize((int)spec.numChannels, (int)spec.maximumBlockSize << 4);
+    morphPosition.reset(spec.sampleRate, morphRampSeconds);
+
+    // The filters start from their own parameters; the snapshots are picked
+    // up again by the first block.
+    morphEngaged = false;
+    morphSplit = false;
+    snapshotVersion = 0;
 
-    reset();
     update();
+    updateTailLength();
+    reset();
 }
 
 template <typename SampleType>
 void ProcessWrapper<SampleType>::reset()
 {
+    NLFILTER_TRACE_SCOPE(*tracer, "reset");
+
     mixer.reset();
-    //mixer.setWetLatency(static_cast<SampleType>(audioProcessor.getLatencySamples()));
-    driveUp.reset();
+    multiband.reset();
     filter.reset();
-    driveDn.reset();
-    output.reset();
+    fadeFilter.reset();
+    morphFilter.reset();
+    equaliser.reset();
+    fadeEqualiser.reset();
+    resetGains();
 
     for (int i = 0; i < 5; ++i)
+    {
         oversampler[i]->reset();
+        padding[i].reset();
+    }
+
+    morphPosition.setCurrentAndTargetValue(morphPosition.getTargetValue());
+    morphFrom = morphTo = morphPosition.getCurrentValue();
+
+    fade.setCurrentAndTargetValue(1.0);
+    finishFade();
+    isSwitching = false;
+
+    std::fill(silentSamples.begin(), silentSamples.end(), 0);
+    isAsleep = false;
 }
 
 //==============================================================================
@@ -90,56 +208,849 @@ void ProcessWrapper<SampleType>::process(juce::AudioBuffer<SampleType>& buffer,
 {
     midiMessages.clear();
 
-    update();
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+
+    const auto numSamples = (int)block.getNumSamples();
+
+    NLFILTER_PROFILE_BLOCK(profiler, numSamples, setup.sampleRate);
+
+    // The queues are only scanned when something has been pushed since the
+    // last block, which is rare for an instance that is not being automated.
+    // Parameter listeners carry no sample position, so the events pushed
+    // since the last block are spread over this one: the first of each
+    // parameter applies here, and the rest one per segment below.
+    const auto version = eventVersion.load(std::memory_order_acquire);
+    auto hasEvents = false;
+
+    pullSnapshots();
+
+    if (version != appliedVersion)
+    {
+        appliedVersion = version;
+        hasEvents = applyEvents(numSamples <= segmentSamples);
+    }
+
+    const auto iterations = maxIterations.load(std::memory_order_relaxed);
+
+    if (iterations != appliedIterations)
+    {
+        appliedIterations = iterations;
+
+        for (auto* f : { &filter, &fadeFilter, &morphFilter })
+            f->setMaxIterations(iterations);
+    }
+
     setOversampling();
 
-    juce::dsp::AudioBlock<SampleType> block(buffer);
-    juce::dsp::AudioBlock<SampleType> osBlock(buffer);
+    if (tailDirty)
+        updateTailLength();
+
+    const auto numAwake = detectSilence(block);
+
+    if (numAwake == 0)
+    {
+        // With nothing to hear them on, the rest of the events apply at once.
+        if (hasEvents)
+        {
+            applyEvents(true);
+            setOversampling();
+        }
+
+        sleep();
+
+        // Keep the morph current so the chain wakes up as it should.
+        if (morphEngaged)
+            applyMorph(numSamples);
+
+        fade.setCurrentAndTargetValue(1.0);
+
+        if (isFading)
+            finishFade();
+
+        isSwitching = false;
+        block.clear();
+        return;
+    }
+
+    isAsleep = false;
+
+    // Channels asleep at the end of the block are left out of the chain
+    // altogether, so they cost nothing but the silence written to them. One
+    // asleep ahead of an awake channel still runs through the oversampling
+    // and the mixer, which keep their state by channel position, and only
+    // skips the filter.
+    for (auto channel = numAwake; channel < block.getNumChannels(); ++channel)
+        block.getSingleChannelBlock(channel).clear();
+
+    auto awakeBlock = block.getSubsetChannelBlock(0, numAwake);
+
+    for (int start = 0; start < numSamples;)
+    {
+        auto end = numSamples;
+
+        // While events are pending, the block runs in segments of
+        // segmentSamples, with the next event of each parameter applied at
+        // the start of each; the last segment takes whatever is left.
+        if (hasEvents)
+        {
+            end = juce::jmin(end, start + segmentSamples);
+
+            if (start > 0)
+            {
+                hasEvents = applyEvents(end == numSamples);
+                setOversampling();
+            }
+        }
+
+        // A moving morph is redesigned every segmentSamples, rather than
+        // every sample.
+        if (morphEngaged && (morphDirty || morphPosition.isSmoothing()))
+        {
+            end = juce::jmin(end, start + segmentSamples);
+            applyMorph(end - start);
+        }
+
+        else
+        {
+            morphFrom = morphTo;
+        }
+
+        auto segment = awakeBlock.getSubBlock((size_t)start, (size_t)(end - start));
+        processSegment(segment);
+
+        start = end;
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::updateTailLength()
+{
+    NLFILTER_PROFILE_STAGE(profiler, control);
+
+    filter.updateCoefficients();
+
+    const auto maxSamples = static_cast<SampleType>(maxTailSeconds * setup.sampleRate * oversamplingFactor);
+    equaliser.updateCoefficients();
+
+    const auto filterSamples = (filter.getDecaySamples(silenceLevel, maxSamples)
+                              + equaliser.getDecaySamples(silenceLevel, maxSamples)) / static_cast<SampleType>(oversamplingFactor);
+    const auto latencySamples = getLatencySamples();
+
+    tailSamples = (int)std::ceil(filterSamples + latencySamples);
+    tailSeconds.store(tailSamples / setup.sampleRate, std::memory_order_relaxed);
+    tailDirty = false;
+}
 
-    mixer.pushDrySamples(block);
+template <typename SampleType>
+size_t ProcessWrapper<SampleType>::detectSilence(const juce::dsp::AudioBlock<SampleType>& block)
+{
+    NLFILTER_PROFILE_STAGE(profiler, control);
+
+    const auto numSamples = (int)block.getNumSamples();
+    const auto maxSilentSamples = std::numeric_limits<int>::max() / 2;
+    size_t numAwake = 0;
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* samples = block.getChannelPointer(channel);
+        auto peak = static_cast<SampleType>(0.0);
 
-    osBlock = oversampler[curOS]->processSamplesUp(block);
+        for (int i = 0; i < numSamples; ++i)
+            peak = juce::jmax(peak, std::abs(samples[i]));
+
+        // A channel sleeps once its input has been silent for longer than the
+        // tail, and wakes on the first block that carries any signal.
+        auto& count = silentSamples[channel];
+        const auto isSilent = peak < silenceLevel;
+        const auto shouldSleep = isSilent && count >= tailSamples;
+
+        count = isSilent ? juce::jmin(count + numSamples, maxSilentSamples) : 0;
+
+        filter.setChannelAsleep((int)channel, shouldSleep);
+        morphFilter.setChannelAsleep((int)channel, shouldSleep);
+
+        if (! shouldSleep)
+            numAwake = channel + 1;
+    }
+
+    return numAwake;
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::sleep()
+{
+    NLFILTER_PROFILE_STAGE(profiler, control);
+
+    if (isAsleep)
+        return;
+
+    mixer.reset();
+    multiband.reset();
+    filter.reset();
+    fadeFilter.reset();
+    morphFilter.reset();
+    equaliser.reset();
+    fadeEqualiser.reset();
+    resetGains();
+
+    for (int i = 0; i < 5; ++i)
+    {
+        oversampler[i]->reset();
+        padding[i].reset();
+    }
+
+    isAsleep = true;
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::processSegment(juce::dsp::AudioBlock<SampleType>& block)
+{
+    juce::dsp::AudioBlock<SampleType> osBlock(block);
+
+    // At 100% mix the mixer only copies the wet signal back, so it is left
+    // out once its own ramp towards 100% has had time to finish.
+    const auto useMixer = ! (mixIsFullyWet && mixRampSamples <= 0);
+    mixRampSamples = juce::jmax(0, mixRampSamples - (int)block.getNumSamples());
+
+    if (useMixer)
+    {
+        NLFILTER_PROFILE_STAGE(profiler, mixer);
+        mixer.pushDrySamples(block);
+    }
+
+    {
+        NLFILTER_PROFILE_STAGE(profiler, filter);
+        NLFILTER_TRACE_SCOPE(*tracer, "split");
+        multiband.process(block);
+    }
+
+    if (isFading)
+        processFadeOut(block);
+
+    {
+        NLFILTER_PROFILE_STAGE(profiler, upsampling);
+        NLFILTER_TRACE_SCOPE(*tracer, "upsample");
+        osBlock = oversampler[curOS]->processSamplesUp(block);
+    }
+
+    {
+        NLFILTER_PROFILE_STAGE(profiler, filter);
+        juce::dsp::ProcessContextReplacing context(osBlock);
+
+        auto morphBlock = juce::dsp::AudioBlock<SampleType>(morphBuffer)
+            .getSubsetChannelBlock(0, osBlock.getNumChannels())
+            .getSubBlock(0, osBlock.getNumSamples());
+
+        auto switchBlock = juce::dsp::AudioBlock<SampleType>(fadeBuffer)
+            .getSubsetChannelBlock(0, osBlock.getNumChannels())
+            .getSubBlock(0, osBlock.getNumSamples());
+
+        // The B configuration, and the outgoing one of a switch, replay the
+        // same gain ramps as the A one.
+        if (morphSplit)
+        {
+            auto morphDrive = driveGain;
+            auto morphOutput = outputGain;
+
+            morphBlock.copyFrom(osBlock);
+            juce::dsp::ProcessContextReplacing morphContext(morphBlock);
+            morphFilter.process(morphContext, morphDrive, morphOutput);
+        }
+
+        if (isSwitching)
+        {
+            auto switchDrive = driveGain;
+            auto switchOutput = outputGain;
+
+            switchBlock.copyFrom(osBlock);
+            juce::dsp::ProcessContextReplacing switchContext(switchBlock);
+            fadeFilter.process(switchContext, switchDrive, switchOutput);
+        }
+
+        // Drive, filter, inverse drive and output run as one pass per channel.
+        filter.process(context, driveGain, outputGain);
+
+        if (morphSplit)
+            mixMorph(osBlock, morphBlock);
+
+        if (isSwitching)
+            mixSwitch(osBlock, switchBlock);
+
+        equaliser.process(context);
+    }
+
+    {
+        NLFILTER_PROFILE_STAGE(profiler, downsampling);
+        NLFILTER_TRACE_SCOPE(*tracer, "downsample");
+        oversampler[curOS]->processSamplesDown(block);
+        padding[curOS].process(block);
+    }
+
+    if (isFading)
+        mixFadeOut(block);
+
+    if (useMixer)
+    {
+        NLFILTER_PROFILE_STAGE(profiler, mixer);
+        mixer.mixWetSamples(block);
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::processFadeOut(juce::dsp::AudioBlock<SampleType>& block)
+{
+    NLFILTER_PROFILE_STAGE(profiler, crossfade);
+    NLFILTER_TRACE_SCOPE(*tracer, "crossfade resample");
+
+    auto fadeBlock = juce::dsp::AudioBlock<SampleType>(fadeBuffer)
+        .getSubsetChannelBlock(0, block.getNumChannels())
+        .getSubBlock(0, block.getNumSamples());
+
+    fadeBlock.copyFrom(block);
+
+    auto osBlock = oversampler[fadeOS]->processSamplesUp(fadeBlock);
 
     juce::dsp::ProcessContextReplacing context(osBlock);
 
-    driveUp.process(context);
+    // The gain ramps belong to the incoming chain, so the outgoing chain
+    // just applies their target values rather than stepping them.
+    auto fadeDrive = driveGain;
+    auto fadeOutput = outputGain;
+    fadeDrive.setCurrentAndTargetValue(driveGain.getTargetValue());
+    fadeOutput.setCurrentAndTargetValue(outputGain.getTargetValue());
+
+    fadeFilter.process(context, fadeDrive, fadeOutput);
+    fadeEqualiser.process(context);
+
+    oversampler[fadeOS]->processSamplesDown(fadeBlock);
+    padding[fadeOS].process(fadeBlock);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::mixFadeOut(juce::dsp::AudioBlock<SampleType>& block)
+{
+    NLFILTER_PROFILE_STAGE(profiler, crossfade);
+
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto gain = fade.getNextValue();
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* fadeSamples = fadeBuffer.getReadPointer((int)channel);
+            auto* outputSamples = block.getChannelPointer(channel);
 
-    filter.process(context);
+            outputSamples[i] = fadeSamples[i] + (gain * (outputSamples[i] - fadeSamples[i]));
+        }
+    }
 
-    driveDn.process(context);
+    if (! fade.isSmoothing())
+        finishFade();
+}
 
-    output.process(context);
+template <typename SampleType>
+void ProcessWrapper<SampleType>::finishFade()
+{
+    isFading = false;
 
-    oversampler[curOS]->processSamplesDown(block);
+    for (auto& delay : padding)
+        delay.setDelaySamples(0);
 
-    mixer.mixWetSamples(block);
+    setWetLatency();
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::setWetLatency()
+{
+    auto latency = osLatency[curOS];
+
+    if (isFading)
+        latency = juce::jmax(latency, osLatency[fadeOS]);
+
+    latency += multiband.getLatencySamples();
+
+    jassert(latency <= maxMixerLatency);
+    mixer.setWetLatency(static_cast<SampleType>(latency));
 }
 
 template <typename SampleType>
 void ProcessWrapper<SampleType>::update()
 {
-    mixer.setWetMixProportion(mixPtr->get() * 0.01f);
-    driveUp.setGainDecibels(drivePtr->get());
-    filter.setFrequency(frequencyPtr->get() / oversamplingFactor);
-    filter.setResonance(resonancePtr->get());
-    filter.setGain(gainPtr->get());
-    filter.setFilterType(static_cast<FilterType>(typePtr->getIndex()));
-    filter.setSaturationType(static_cast<SaturationType>(linearityPtr->getIndex()));
-    driveDn.setGainDecibels(drivePtr->get() * static_cast<SampleType>(-1.0));
-    output.setGainDecibels(outputPtr->get());
+    for (int i = 0; i < numParameters; ++i)
+        applyParameter(i, queues[(size_t)i].getLatest());
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::applyParameter(int index, float value)
+{
+    // While morphing, these come from the snapshots instead; the latest
+    // values stay queued for when the morph lets go.
+    if (morphEngaged && isMorphed(index))
+        return;
+
+    tailDirty = true;
+
+    // Filter settings go to the outgoing filter as well while it is fading,
+    // and to the B configuration while morphing between two.
+    auto applyToFilters = [this](auto&& setter)
+    {
+        setter(filter, oversamplingFactor);
+
+        if (isFading)
+            setter(fadeFilter, 1 << fadeOS);
+
+        if (morphSplit)
+            setter(morphFilter, oversamplingFactor);
+    };
+
+    // The equaliser bands follow the global filter settings too.
+    auto applyToEqualisers = [this](auto&& setter)
+    {
+        setter(equaliser);
+
+        if (isFading)
+            setter(fadeEqualiser);
+    };
+
+    switch (index)
+    {
+    case frequencyIndex:
+        frequency = value;
+        applyToFilters([value](auto& f, int factor) { f.setFrequency(static_cast<SampleType>(value / factor)); });
+        break;
+    case resonanceIndex:
+        applyToFilters([value](auto& f, int) { f.setResonance(static_cast<SampleType>(value)); });
+        break;
+    case gainIndex:
+        applyToFilters([value](auto& f, int) { f.setGain(static_cast<SampleType>(value)); });
+        break;
+    case driveIndex:
+        driveDecibels = static_cast<SampleType>(value);
+        driveGain.setTargetValue(juce::Decibels::decibelsToGain(driveDecibels));
+        outputGain.setTargetValue(juce::Decibels::decibelsToGain(outputDecibels - driveDecibels));
+        break;
+    case typeIndex:
+        applyToFilters([value](auto& f, int) { f.setFilterType(static_cast<FilterType>(juce::roundToInt(value))); });
+        break;
+    case linearityIndex:
+        applyToFilters([value](auto& f, int) { f.setSaturationType(static_cast<SaturationType>(juce::roundToInt(value))); });
+        break;
+    case zdfIndex:
+        applyToFilters([value](auto& f, int) { f.setZeroDelayFeedback(value >= 0.5f); });
+        applyToEqualisers([value](auto& e) { e.setZeroDelayFeedback(value >= 0.5f); });
+        break;
+    case engineIndex:
+        applyToFilters([value](auto& f, int) { f.setEngine(static_cast<FilterEngine>(juce::roundToInt(value))); });
+        applyToEqualisers([value](auto& e) { e.setEngine(static_cast<FilterEngine>(juce::roundToInt(value))); });
+        break;
+    case osIndex:
+        osChoice = juce::roundToInt(value);
+        break;
+    case aaIndex:
+        applyToFilters([value](auto& f, int) { f.setAntiAliasing(static_cast<AntiAliasingType>(juce::roundToInt(value))); });
+        applyToEqualisers([value](auto& e) { e.setAntiAliasing(static_cast<AntiAliasingType>(juce::roundToInt(value))); });
+        break;
+    case denormalIndex:
+        applyToFilters([value](auto& f, int) { f.setDenormalStrategy(static_cast<DenormalStrategy>(juce::roundToInt(value))); });
+        break;
+    case outputIndex:
+        outputDecibels = static_cast<SampleType>(value);
+        outputGain.setTargetValue(juce::Decibels::decibelsToGain(outputDecibels - driveDecibels));
+        break;
+    case mixIndex:
+        setMix(value);
+        break;
+    case morphIndex:
+        morphPosition.setTargetValue(static_cast<SampleType>(value * 0.01f));
+        break;
+    case splitIndex:
+        multiband.setNumBands(juce::roundToInt(value) + 1);
+        setWetLatency();
+        break;
+    default:
+        if (index >= firstBandIndex)
+            applyBandParameter((index - firstBandIndex) / numBandSettings, (index - firstBandIndex) % numBandSettings, value);
+        else if (index >= firstCrossoverIndex)
+            applySplitParameter(index, value);
+        break;
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::applySplitParameter(int index, float value)
+{
+    // The split runs at the base rate, so its crossovers need no scaling by
+    // the oversampling factor.
+    if (index >= firstSplitLinearityIndex)
+        multiband.setSaturationType(index - firstSplitLinearityIndex, static_cast<SaturationType>(juce::roundToInt(value)));
+    else if (index >= firstSplitDriveIndex)
+        multiband.setDrive(index - firstSplitDriveIndex, static_cast<SampleType>(value));
+    else
+        multiband.setCrossover(index - firstCrossoverIndex, static_cast<SampleType>(value));
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::applyBandParameter(int band, int setting, float value)
+{
+    // As with the filter, the outgoing chain follows the settings while it is
+    // fading out, at its own factor.
+    auto applyToEqualisers = [this](auto&& setter)
+    {
+        setter(equaliser, oversamplingFactor);
+
+        if (isFading)
+            setter(fadeEqualiser, 1 << fadeOS);
+    };
+
+    switch (setting)
+    {
+    case bandEnabled:
+        applyToEqualisers([band, value](auto& e, int) { e.setBandEnabled(band, value >= 0.5f); });
+        break;
+    case bandFrequency:
+        bandFrequencies[(size_t)band] = value;
+        applyToEqualisers([band, value](auto& e, int factor) { e.setFrequency(band, static_cast<SampleType>(value / factor)); });
+        break;
+    case bandResonance:
+        applyToEqualisers([band, value](auto& e, int) { e.setResonance(band, static_cast<SampleType>(value)); });
+        break;
+    case bandGain:
+        applyToEqualisers([band, value](auto& e, int) { e.setGain(band, static_cast<SampleType>(value)); });
+        break;
+    case bandType:
+        applyToEqualisers([band, value](auto& e, int) { e.setFilterType(band, static_cast<FilterType>(juce::roundToInt(value))); });
+        break;
+    case bandLinearity:
+        applyToEqualisers([band, value](auto& e, int) { e.setSaturationType(band, static_cast<SaturationType>(juce::roundToInt(value))); });
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::applyEvents(bool applyAll)
+{
+    NLFILTER_PROFILE_STAGE(profiler, control);
+
+    auto isPending = false;
+
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+        auto& queue = queues[i];
+        ParameterQueue::Event event;
+
+        // Events were dropped while the queue was full, so jump straight to
+        // the most recent value once the remaining events have been applied.
+        const auto overflowed = queue.checkAndClearOverflow();
+
+        while (queue.peek(event))
+        {
+            applyParameter((int)i, event.value);
+            queue.pop();
+
+            if (! (applyAll || overflowed))
+                break;
+        }
+
+        if (overflowed)
+            applyParameter((int)i, queue.getLatest());
+
+        isPending = isPending || queue.peek(event);
+    }
+
+    return isPending;
+}
+
+//==============================================================================
+template <typename SampleType>
+void ProcessWrapper<SampleType>::parameterValueChanged(int parameterIndex, float newValue)
+{
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (parameters[i]->getParameterIndex() == parameterIndex)
+        {
+            queues[i].push(parameters[i]->convertFrom0to1(newValue));
+            NLFILTER_TRACE_INSTANT(*tracer, i <= (size_t)splitIndex ? parameterTraceNames[i] : (i < (size_t)firstBandIndex ? "split" : "band"), parameters[i]->convertFrom0to1(newValue));
+            eventVersion.fetch_add(1, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::parameterGestureChanged(int, bool)
+{
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::resetGains()
+{
+    // Ramps step once per oversampled sample, and reset() lands on the target.
+    const auto osRate = setup.sampleRate * oversamplingFactor;
+
+    if (osRate <= 0.0)
+        return;
+
+    driveGain.reset(osRate, gainRampSeconds);
+    outputGain.reset(osRate, gainRampSeconds);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::setMix(float value)
+{
+    mixer.setWetMixProportion(static_cast<SampleType>(value * 0.01f));
+    mixIsFullyWet = value >= 100.0f;
+    mixRampSamples = (int)std::ceil(mixRampSeconds * setup.sampleRate);
+}
+
+//==============================================================================
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::isMorphed(int index) noexcept
+{
+    switch (index)
+    {
+    case frequencyIndex:
+    case resonanceIndex:
+    case gainIndex:
+    case driveIndex:
+    case typeIndex:
+    case linearityIndex:
+    case outputIndex:
+    case mixIndex:
+        return true;
+    default:
+        return false;
+    }
 }
 
+template <typename SampleType>
+void ProcessWrapper<SampleType>::pullSnapshots()
+{
+    NLFILTER_PROFILE_STAGE(profiler, control);
+
+    const auto wasEngaged = morphEngaged;
+
+    if (! snapshots.pull(morphA, morphB, morphEngaged, snapshotVersion))
+        return;
+
+    tailDirty = true;
+
+    if (! morphEngaged)
+    {
+        // Hand the settings back to their own parameters, crossfading if
+        // that changes the configuration the filter runs.
+        if (wasEngaged)
+        {
+            const auto type = static_cast<FilterType>(juce::roundToInt(queues[typeIndex].getLatest()));
+            const auto linearity = static_cast<SaturationType>(juce::roundToInt(queues[linearityIndex].getLatest()));
+
+            if (morphSplit || filter.getFilterType() != type || filter.getSaturationType() != linearity)
+                startSwitch();
+
+            morphSplit = false;
+            update();
+        }
+
+        return;
+    }
+
+    const auto typeA = static_cast<FilterType>(juce::roundToInt(morphA[MorphSnapshots::type]));
+    const auto typeB = static_cast<FilterType>(juce::roundToInt(morphB[MorphSnapshots::type]));
+    const auto linearityA = static_cast<SaturationType>(juce::roundToInt(morphA[MorphSnapshots::linearity]));
+    const auto linearityB = static_cast<SaturationType>(juce::roundToInt(morphB[MorphSnapshots::linearity]));
+
+    // The B configuration takes the remaining settings, and the state, of
+    // the filter when it starts.
+    const auto shouldSplit = typeA != typeB || linearityA != linearityB;
+
+    const auto changesA = filter.getFilterType() != typeA || filter.getSaturationType() != linearityA;
+    const auto changesB = shouldSplit && (! morphSplit || morphFilter.getFilterType() != typeB || morphFilter.getSaturationType() != linearityB);
+
+    if (changesA || changesB)
+        startSwitch();
+
+    if (shouldSplit && ! morphSplit)
+        morphFilter.copyStateFrom(filter);
+
+    filter.setFilterType(typeA);
+    filter.setSaturationType(linearityA);
+
+    morphSplit = shouldSplit;
+
+    if (morphSplit)
+    {
+        morphFilter.setFilterType(typeB);
+        morphFilter.setSaturationType(linearityB);
+    }
+
+    if (! wasEngaged)
+    {
+        morphPosition.setCurrentAndTargetValue(morphPosition.getTargetValue());
+        morphTo = morphPosition.getCurrentValue();
+    }
+
+    morphDirty = true;
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::applyMorph(int numSamples)
+{
+    NLFILTER_PROFILE_STAGE(profiler, control);
+
+    morphFrom = morphPosition.getCurrentValue();
+    morphPosition.skip(numSamples);
+    morphTo = morphPosition.getCurrentValue();
+    morphDirty = false;
+    tailDirty = true;
+
+    const auto position = static_cast<float>(morphFrom);
+
+    auto lerp = [&](int setting)
+    {
+        return morphA[(size_t)setting] + position * (morphB[(size_t)setting] - morphA[(size_t)setting]);
+    };
+
+    // Frequency moves evenly in octaves rather than in hertz.
+    frequency = morphA[MorphSnapshots::frequency]
+              * std::pow(morphB[MorphSnapshots::frequency] / morphA[MorphSnapshots::frequency], position);
+
+    const auto hz = static_cast<SampleType>(frequency / oversamplingFactor);
+    const auto resonance = static_cast<SampleType>(lerp(MorphSnapshots::resonance));
+    const auto gain = static_cast<SampleType>(lerp(MorphSnapshots::gain));
+
+    filter.setFrequency(hz);
+    filter.setResonance(resonance);
+    filter.setGain(gain);
+
+    if (morphSplit)
+    {
+        morphFilter.setFrequency(hz);
+        morphFilter.setResonance(resonance);
+        morphFilter.setGain(gain);
+    }
+
+    driveDecibels = static_cast<SampleType>(lerp(MorphSnapshots::drive));
+    outputDecibels = static_cast<SampleType>(lerp(MorphSnapshots::output));
+    driveGain.setTargetValue(juce::Decibels::decibelsToGain(driveDecibels));
+    outputGain.setTargetValue(juce::Decibels::decibelsToGain(outputDecibels - driveDecibels));
+
+    setMix(lerp(MorphSnapshots::mix));
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::mixMorph(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& morphBlock)
+{
+    NLFILTER_PROFILE_STAGE(profiler, crossfade);
+
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+    const auto step = (morphTo - morphFrom) / static_cast<SampleType>(numSamples);
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto* samples = block.getChannelPointer(channel);
+        auto* morphSamples = morphBlock.getChannelPointer(channel);
+        auto weight = morphFrom;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            samples[i] += weight * (morphSamples[i] - samples[i]);
+            weight += step;
+        }
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::startSwitch()
+{
+    // The oversampling fade already has the fade slot, and crossfades from
+    // the old configuration anyway.
+    if (isFading)
+        return;
+
+    fadeFilter.copyStateFrom(filter);
+
+    switchFade.reset(setup.sampleRate * oversamplingFactor, fadeSeconds);
+    switchFade.setCurrentAndTargetValue(0.0);
+    switchFade.setTargetValue(1.0);
+    isSwitching = true;
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::mixSwitch(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& switchBlock)
+{
+    NLFILTER_PROFILE_STAGE(profiler, crossfade);
+
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto gain = switchFade.getNextValue();
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* switchSamples = switchBlock.getChannelPointer(channel);
+            auto* outputSamples = block.getChannelPointer(channel);
+
+            outputSamples[i] = switchSamples[i] + (gain * (outputSamples[i] - switchSamples[i]));
+        }
+    }
+
+    if (! switchFade.isSmoothing())
+        isSwitching = false;
+}
+
+//==============================================================================
 template <typename SampleType>
 void ProcessWrapper<SampleType>::setOversampling()
 {
-    curOS = (int)osPtr->getIndex();
+    NLFILTER_PROFILE_STAGE(profiler, control);
+
+    curOS = osChoice;
     if (curOS != prevOS)
     {
+        // The outgoing factor carries on in the fade slot from exactly where
+        // it left off, while the filter keeps its state into the new factor.
+        // Until the crossfade ends, the faster of the two is padded out to the
+        // latency of the slower, so they crossfade in step. It takes over the
+        // fade slot from any switch of configuration still running.
+        isSwitching = false;
+        fadeOS = prevOS;
+        fadeFilter.copyStateFrom(filter);
+        fadeEqualiser.copyStateFrom(equaliser);
+        oversampler[curOS]->reset();
+        padding[curOS].reset();
+
+        const auto fadeLatency = juce::jmax(osLatency[curOS], osLatency[fadeOS]);
+        padding[curOS].setDelaySamples(fadeLatency - osLatency[curOS]);
+        padding[fadeOS].setDelaySamples(fadeLatency - osLatency[fadeOS]);
+
         oversamplingFactor = 1 << curOS;
         prevOS = curOS;
-        mixer.reset();
-        filter.reset();
-        output.reset();
+        tailDirty = true;
+
+        equaliser.setOversamplingFactor(oversamplingFactor);
+        fadeEqualiser.setOversamplingFactor(1 << fadeOS);
+
+        fade.setCurrentAndTargetValue(0.0);
+        fade.setTargetValue(1.0);
+        isFading = true;
+        setWetLatency();
+
+        filter.setFrequency(static_cast<SampleType>(frequency / oversamplingFactor));
+
+        if (morphSplit)
+            morphFilter.setFrequency(static_cast<SampleType>(frequency / oversamplingFactor));
+
+        for (int band = 0; band < Parameters::numBands; ++band)
+            equaliser.setFrequency(band, static_cast<SampleType>(bandFrequencies[(size_t)band] / oversamplingFactor));
+
+        resetGains();
     }
 }
 
@@ -16,11 +16,19 @@
 #include <JuceHeader.h>
 
 #include "Modules/SecondOrderNLFilter.h"
+#include "Modules/FilterChain.h"
+#include "Modules/MultibandSaturator.h"
+#include "Modules/LatencyDelay.h"
+#include "Modules/ParameterQueue.h"
+#include "Modules/MorphSnapshots.h"
+#include "Modules/StageProfiler.h"
+#include "Modules/TraceRecorder.h"
+#include "PluginParameters.h"
 
 class SecondOrderNonLinearFilterAudioProcessor;
 
 template <typename SampleType>
-class ProcessWrapper
+class ProcessWrapper : private juce::AudioProcessorParameter::Listener
 {
 public:
     using APVTS = juce::AudioProcessorValueTreeState;
@@ -29,6 +37,9 @@ public:
     /** Constructor. */
     ProcessWrapper(SecondOrderNonLinearFilterAudioProcessor& p);
 
+    /** Destructor. */
+    ~ProcessWrapper() override;
+
     //==========================================================================
     /** Initialises the processor. */
     void prepare(juce::dsp::ProcessSpec& spec);
@@ -40,12 +51,171 @@ public:
     void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
 
     //==========================================================================
-    /** Updates the internal state variables of the processor. */
+    /** Updates the internal state variables of the processor with the latest
+    value of every parameter. */
     void update();
 
+    /** Sets the oversampling factor. A change of factor starts a crossfade
+    from the outgoing chain to the incoming one. */
     void setOversampling();
 
+    //==========================================================================
+    /** Returns the length of the tail for the current settings, including
+    the latency of the chain. */
+    double getTailLengthSeconds() const noexcept { return tailSeconds.load(std::memory_order_relaxed); }
+
+    /** Returns the latency of the chain, in samples: the oversampling at the
+    current factor, and the multiband split while it has more than one band.
+    It changes with those settings, as soon as the block that applies them. */
+    int getLatencySamples() const noexcept { return osLatency[curOS] + multiband.getLatencySamples(); }
+
+    /** Returns the number of subnormal filter states seen since the last reset. */
+    int getSubnormalCount() const noexcept { return filter.getSubnormalCount() + fadeFilter.getSubnormalCount() + morphFilter.getSubnormalCount(); }
+
+    /** Returns the average number of zero-delay feedback solver iterations per
+    sample of the filter, over its last block. */
+    float getAverageIterations() const noexcept { return filter.getAverageIterations(); }
+
+    /** Returns the largest number of solver iterations any of the filters has
+    taken in one sample since playback was prepared. */
+    int getMaxIterationsUsed() const noexcept { return juce::jmax(filter.getMaxIterationsUsed(), fadeFilter.getMaxIterationsUsed(), morphFilter.getMaxIterationsUsed()); }
+
+    /** Sets the maximum number of solver iterations per sample of every
+    filter. Safe to call from any thread; the next block applies it. */
+    void setMaxIterations(int newMaxIterations) noexcept { maxIterations.store(juce::jmax(1, newMaxIterations), std::memory_order_relaxed); }
+
+#if NLFILTER_PROFILING
+    /** Returns the per-stage timings. */
+    StageProfiler& getProfiler() noexcept { return profiler; }
+#endif
+
 private:
+    //==========================================================================
+    /** Settings of each equaliser band, in the order of their queues. */
+    enum BandSetting
+    {
+        bandEnabled = 0,
+        bandFrequency,
+        bandResonance,
+        bandGain,
+        bandType,
+        bandLinearity,
+        numBandSettings
+    };
+
+    /** Parameters followed by the wrapper, in the order of their queues. The
+    crossovers and the drive and saturation of each band of the split follow
+    on from splitIndex, and the settings of each equaliser band from
+    firstBandIndex. */
+    enum ParameterIndex
+    {
+        frequencyIndex = 0,
+        resonanceIndex,
+        gainIndex,
+        driveIndex,
+        typeIndex,
+        linearityIndex,
+        zdfIndex,
+        engineIndex,
+        osIndex,
+        aaIndex,
+        denormalIndex,
+        outputIndex,
+        mixIndex,
+        morphIndex,
+        splitIndex,
+        firstCrossoverIndex,
+        firstSplitDriveIndex = firstCrossoverIndex + (Parameters::numSplits - 1),
+        firstSplitLinearityIndex = firstSplitDriveIndex + Parameters::numSplits,
+        firstBandIndex = firstSplitLinearityIndex + Parameters::numSplits,
+        numParameters = firstBandIndex + (Parameters::numBands * numBandSettings)
+    };
+
+    //==========================================================================
+    /** Parameter listener callbacks, called from whichever thread changes the
+    parameter. */
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+
+    //==========================================================================
+    /** Applies the next pending event of each parameter, or all of them if
+    applyAll is true, in the order each parameter received them. Returns true
+    if any events are still pending. */
+    bool applyEvents(bool applyAll);
+
+    /** Applies a single parameter value. */
+    void applyParameter(int index, float value);
+
+    /** Applies a value to a crossover, or to the drive or saturation of a
+    band of the split. */
+    void applySplitParameter(int index, float value);
+
+    /** Applies a value to a setting of an equaliser band. */
+    void applyBandParameter(int band, int setting, float value);
+
+    /** Processes the part of the block between two automation or morph steps. */
+    void processSegment(juce::dsp::AudioBlock<SampleType>& block);
+
+    //==========================================================================
+    /** Runs the outgoing oversampling chain on a copy of the input block. */
+    void processFadeOut(juce::dsp::AudioBlock<SampleType>& block);
+
+    /** Crossfades the outgoing chain into the incoming one. */
+    void mixFadeOut(juce::dsp::AudioBlock<SampleType>& block);
+
+    /** Ends the crossfade, and drops the padding that lined the two chains up. */
+    void finishFade();
+
+    /** Delays the dry signal by the latency of the wet one, which is that of
+    the slower of the two factors while they crossfade. */
+    void setWetLatency();
+
+    /** Resets the gain ramps for the current oversampled rate. */
+    void resetGains();
+
+    /** Sets the wet proportion of the mixer, in percent. */
+    void setMix(float value);
+
+    //==========================================================================
+    /** Returns true if the parameter is driven by the morph while both
+    snapshots are stored. */
+    static bool isMorphed(int index) noexcept;
+
+    /** Picks up new snapshots, and switches the filters between their own
+    parameters and the morph. */
+    void pullSnapshots();
+
+    /** Advances the morph position over the next numSamples, and sets the
+    filters and gains for the position at the start of them. */
+    void applyMorph(int numSamples);
+
+    /** Crossfades from the A configuration to the B configuration by the
+    morph position, ramping across the block. */
+    void mixMorph(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& morphBlock);
+
+    /** Carries the filter on in the fade slot, at the current factor, so it
+    can be crossfaded out while the morph changes its type or saturation,
+    which restarts it. Does nothing during a change of factor. */
+    void startSwitch();
+
+    /** Crossfades the outgoing filter configuration into the incoming one,
+    at the oversampled rate. */
+    void mixSwitch(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& switchBlock);
+
+    //==========================================================================
+    /** Re-estimates the tail length from the current filter poles. Called
+    from prepare() and after the settings change, rather than every block. */
+    void updateTailLength();
+
+    /** Tracks the input level of each channel and puts any channel whose
+    tail has fully decayed to sleep. Returns the number of channels up to and
+    including the last one still awake, which is zero if every channel is
+    asleep. */
+    size_t detectSilence(const juce::dsp::AudioBlock<SampleType>& block);
+
+    /** Drops the whole chain to exact silence while the input is silent. */
+    void sleep();
+
     //==========================================================================
     // This reference is provided as a quick way for the wrapper to
     // access the processor object that created it.
@@ -54,13 +224,53 @@ private:
     ProcessSpec& setup;
 
     //==========================================================================
+    /** Oversampling at each factor, its latency, and the delay that pads it
+    out to the latency of the other factor while the two crossfade. */
     std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler[5];
+    LatencyDelay<SampleType> padding[5];
+    int osLatency[5]{};
+
+    //==========================================================================
+    /** Instantiate objects. The mixer delays the dry signal by the latency of
+    the chain, up to maxMixerLatency samples. */
+    static constexpr int maxMixerLatency = 4096;
+    juce::dsp::DryWetMixer<SampleType> mixer{ maxMixerLatency };
+    SecondOrderNLfilter<SampleType> filter, fadeFilter, morphFilter;
+
+    /** Multiband split, ahead of the filter at the base rate. It does its own
+    oversampling, of all of its bands. */
+    MultibandSaturator<SampleType, Parameters::numSplits> multiband;
+
+    /** Equaliser bands, after the filter at the oversampled rate. The fade
+    copy runs at the outgoing factor while it is crossfaded out. */
+    FilterChain<SampleType, Parameters::numBands> equaliser, fadeEqualiser;
+    std::array<float, (size_t)Parameters::numBands> bandFrequencies{};
 
     //==========================================================================
-    /** Instantiate objects. */
-    juce::dsp::DryWetMixer<SampleType> mixer;
-    SecondOrderNLfilter<SampleType> filter;
-    juce::dsp::Gain<SampleType> driveUp, driveDn, output;
+    /** Gain ramps, applied inside the filter pass at the oversampled rate.
+    The output ramp carries the inverse drive and the output gain together. */
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> driveGain, outputGain;
+    SampleType driveDecibels = 0.0, outputDecibels = 0.0;
+
+    //==========================================================================
+    /** Oversampling crossfade, and the crossfade between filter
+    configurations when the morph engages or lets go. The two never run at
+    once, so they share the buffer of the outgoing chain, which is sized for
+    the highest factor. */
+    juce::AudioBuffer<SampleType> fadeBuffer;
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> fade, switchFade;
+
+    //==========================================================================
+    /** Morph. While the snapshots differ in filter type or saturation, the
+    filter runs the A configuration and morphFilter the B configuration on a
+    copy of the oversampled block, and the two are crossfaded. */
+    MorphSnapshots& snapshots;
+    MorphSnapshots::Snapshot morphA, morphB;
+    juce::AudioBuffer<SampleType> morphBuffer;
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> morphPosition;
+    SampleType morphFrom = 0.0, morphTo = 0.0;
+    uint32_t snapshotVersion = 0;
+    bool morphEngaged = false, morphSplit = false, morphDirty = false;
 
     //==========================================================================
     /** Parameter pointers. */
@@ -69,15 +279,57 @@ private:
     juce::AudioParameterFloat* gainPtr{ nullptr };
     juce::AudioParameterChoice* typePtr{ nullptr };
     juce::AudioParameterChoice* linearityPtr{ nullptr };
+    juce::AudioParameterBool* zdfPtr{ nullptr };
+    juce::AudioParameterChoice* enginePtr{ nullptr };
     juce::AudioParameterChoice* osPtr;
+    juce::AudioParameterChoice* aaPtr{ nullptr };
+    juce::AudioParameterChoice* denormalPtr{ nullptr };
     juce::AudioParameterFloat* outputPtr{ nullptr };
     juce::AudioParameterFloat* mixPtr{ nullptr };
     juce::AudioParameterBool* bypassPtr{ nullptr };
     juce::AudioParameterFloat* drivePtr{ nullptr };
+    juce::AudioParameterFloat* morphPtr{ nullptr };
+    juce::AudioParameterChoice* splitPtr{ nullptr };
+
+    //==========================================================================
+    /** Automation event queues. */
+    std::array<juce::RangedAudioParameter*, numParameters> parameters;
+    std::array<ParameterQueue, numParameters> queues;
+
+    std::atomic<uint32_t> eventVersion{ 0 };
+    uint32_t appliedVersion = 0;
+
+    /** Solver iteration budget, as set and as applied to the filters. */
+    std::atomic<int> maxIterations{ 8 };
+    int appliedIterations = 0;
+
+    //==========================================================================
+    /** Silence detection. */
+    std::vector<int> silentSamples;
+    int tailSamples = 0;
+    bool isAsleep = false, tailDirty = true;
+    std::atomic<double> tailSeconds{ 0.0 };
+
+#if NLFILTER_PROFILING
+    //==========================================================================
+    /** Stage timings. */
+    StageProfiler profiler;
+#endif
+
+#if NLFILTER_TRACING
+    juce::SharedResourcePointer<TraceRecorder> tracer;
+#endif
 
     //==========================================================================
     /** Init variables. */
-    int curOS = 0, prevOS = 0, oversamplingFactor = 1;
+    int curOS = 0, prevOS = 0, fadeOS = 0, osChoice = 0, oversamplingFactor = 1;
+    bool isFading = false, isSwitching = false, mixIsFullyWet = false;
+    int mixRampSamples = 0;
+    float frequency = 1000.0f;
+    const double fadeSeconds = 0.05, mixRampSeconds = 0.05, gainRampSeconds = 0.02, morphRampSeconds = 0.01;
+    const int segmentSamples = 32;
+    const SampleType silenceLevel = static_cast<SampleType>(1.0e-5);
+    const double maxTailSeconds = 10.0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessWrapper)
 };